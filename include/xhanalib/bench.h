@@ -0,0 +1,323 @@
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// xhanalib/bench.h
+//
+// Micro benchmark runner for prototypes: xl::bench, xl::bench_with_setup,
+// xl::do_not_optimize and xl::clobber_memory.
+//
+// Iterations are calibrated so each sample runs for about
+// bench_options::sample_time, after a warm up. Results are per iteration
+// median, MAD (median absolute deviation) and mean with outliers beyond
+// outlier_mad_multiplier * scaled MAD (1.4826 * MAD) rejected.
+//
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#pragma once
+
+#ifndef INCLUDE_XHANALIB_BENCH_H
+#define INCLUDE_XHANALIB_BENCH_H
+
+#include "config.h"
+#include "log.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if XHANALIB_DEFINE_FUNCTIONS
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#endif
+
+namespace xhanalib
+{
+    // Monotonic clock used for benchmarks, high_resolution_clock when it is steady
+    using bench_clock = std::conditional_t<std::chrono::high_resolution_clock::is_steady,
+        std::chrono::high_resolution_clock, std::chrono::steady_clock>;
+
+    // Keep the compiler from optimizing away value or the code computing it.
+    //
+    // Usage:
+    //   xl::do_not_optimize(compute());
+    template <typename T>
+    inline auto do_not_optimize(T const& value) -> void
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+        (void)*sink;
+        _ReadWriteBarrier();
+#endif
+    }
+
+    // Force pending memory writes to be treated as observed
+    inline auto clobber_memory() -> void
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#else
+        _ReadWriteBarrier();
+#endif
+    }
+
+    struct bench_options {
+        std::chrono::nanoseconds warmup{ std::chrono::milliseconds(50) };
+        std::chrono::nanoseconds sample_time{ std::chrono::milliseconds(10) };
+        std::size_t samples{ 25 };
+        double outlier_mad_multiplier{ 3.0 };   // times 1.4826 * MAD, 0 keeps every sample
+        bool log_result{ true };                // xl::log(name, result) when done
+    };
+
+    // All times are nanoseconds per iteration
+    struct bench_result {
+        std::string name;
+        std::uint64_t iterations{ 0 };          // per sample
+        std::size_t samples{ 0 };               // kept after outlier rejection
+        std::size_t outliers{ 0 };
+        double median_ns{ 0.0 };
+        double mad_ns{ 0.0 };
+        double mean_ns{ 0.0 };
+        double min_ns{ 0.0 };
+        double max_ns{ 0.0 };
+    };
+
+    // Statistics over per iteration sample times. Samples further than
+    // outlier_mad_multiplier * scaled MAD (1.4826 * MAD, about one standard
+    // deviation for normal data) from the median are dropped first. When the
+    // MAD is 0, e.g. most samples tie on a coarse clock, only samples equal
+    // to the median are kept.
+    XHANALIB_INLINE auto summarize_bench_samples(std::string name, std::uint64_t iterations,
+        std::vector<double> sample_ns, double outlier_mad_multiplier) -> bench_result;
+
+    // {"name":"...","iterations":...,"samples":...,"outliers":...,"median_ns":...,...}
+    XHANALIB_INLINE auto to_json(const bench_result& result) -> std::string;
+
+    // Human readable, lets xl::log("bench", result) work
+    XHANALIB_INLINE auto operator<<(std::ostream& os, const bench_result& result) -> std::ostream &;
+
+    namespace detail
+    {
+        template <typename Fn>
+        inline auto bench_call(Fn& fn) -> void
+        {
+            if constexpr (std::is_void_v<decltype(fn())>) {
+                fn();
+            }
+            else {
+                do_not_optimize(fn());
+            }
+        }
+
+        // Time a batch of iterations, timed_batch(n) -> nanoseconds
+        template <typename TimedBatch>
+        inline auto run_bench(const std::string& name, TimedBatch&& timed_batch,
+            const bench_options& options) -> bench_result
+        {
+            const auto sample_time = static_cast<double>(options.sample_time.count());
+
+            // Warm up, growing the batch to calibrate iterations per sample
+            constexpr std::uint64_t max_iterations = std::uint64_t{ 1 } << 40;
+            std::uint64_t iterations = 1;
+            double elapsed = 0.0;
+            const auto warmup_end = bench_clock::now() + options.warmup;
+            do {
+                elapsed = timed_batch(iterations);
+                if (elapsed < sample_time && iterations < max_iterations) {
+                    // Aim a little past the target, at most 10x per round
+                    double scale = (elapsed > 0.0) ? sample_time * 1.2 / elapsed : 10.0;
+                    scale = (scale > 10.0) ? 10.0 : (scale < 2.0 ? 2.0 : scale);
+                    iterations = static_cast<std::uint64_t>(static_cast<double>(iterations) * scale);
+                    iterations = (iterations > max_iterations) ? max_iterations : iterations;
+                }
+                else if (bench_clock::now() >= warmup_end) {
+                    break;
+                }
+            } while (true);
+
+            std::vector<double> sample_ns;
+            sample_ns.reserve(options.samples);
+            for (std::size_t i = 0; i < options.samples; i++) {
+                sample_ns.push_back(timed_batch(iterations) / static_cast<double>(iterations));
+            }
+
+            auto result = summarize_bench_samples(name, iterations, std::move(sample_ns),
+                options.outlier_mad_multiplier);
+            if (options.log_result) {
+                xhanalib::log("bench", result);
+            }
+            return result;
+        }
+
+        inline auto elapsed_ns(bench_clock::time_point start, bench_clock::time_point stop) -> double
+        {
+            return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+        }
+    }
+
+    // Benchmark fn(). A non-void return value is passed to do_not_optimize.
+    //
+    // Usage:
+    //   auto r = xl::bench("to_string", [] { return xl::to_string(12345); });
+    //   xl::log("median ns", r.median_ns);
+    template <typename Fn>
+    auto bench(const std::string& name, Fn&& fn, const bench_options& options = {}) -> bench_result
+    {
+        return detail::run_bench(name, [&fn](std::uint64_t iterations) {
+            const auto start = bench_clock::now();
+            for (std::uint64_t i = 0; i < iterations; i++) {
+                detail::bench_call(fn);
+                // Keeps the loop itself, an empty fn would be optimized out
+                do_not_optimize(i);
+            }
+            clobber_memory();
+            return detail::elapsed_ns(start, bench_clock::now());
+        }, options);
+    }
+
+    // Benchmark fn(state) where state = setup() runs before every iteration
+    // and is excluded from timing. Each iteration is timed on its own, so
+    // results include one clock read (tens of ns) per iteration.
+    //
+    // Usage:
+    //   auto r = xl::bench_with_setup("sort",
+    //       [] { return make_shuffled_vector(); },
+    //       [](auto& v) { std::sort(v.begin(), v.end()); });
+    template <typename Setup, typename Fn>
+    auto bench_with_setup(const std::string& name, Setup&& setup, Fn&& fn,
+        const bench_options& options = {}) -> bench_result
+    {
+        return detail::run_bench(name, [&setup, &fn](std::uint64_t iterations) {
+            double total = 0.0;
+            for (std::uint64_t i = 0; i < iterations; i++) {
+                auto state = setup();
+                clobber_memory();
+                const auto start = bench_clock::now();
+                auto call = [&fn, &state] { return fn(state); };
+                detail::bench_call(call);
+                clobber_memory();
+                total += detail::elapsed_ns(start, bench_clock::now());
+            }
+            return total;
+        }, options);
+    }
+
+#if XHANALIB_DEFINE_FUNCTIONS
+    namespace detail
+    {
+        // Median of v, reorders v
+        inline auto median_of(std::vector<double>& v) -> double
+        {
+            if (v.empty())
+                return 0.0;
+            const auto mid = v.size() / 2;
+            std::nth_element(v.begin(), v.begin() + mid, v.end());
+            double median = v[mid];
+            if (v.size() % 2 == 0) {
+                median = (median + *std::max_element(v.begin(), v.begin() + mid)) / 2.0;
+            }
+            return median;
+        }
+
+        inline auto median_absolute_deviation(const std::vector<double>& v, double median) -> double
+        {
+            std::vector<double> deviations;
+            deviations.reserve(v.size());
+            for (auto x : v) {
+                deviations.push_back(std::abs(x - median));
+            }
+            return median_of(deviations);
+        }
+    }
+
+    XHANALIB_INLINE auto summarize_bench_samples(std::string name, std::uint64_t iterations,
+        std::vector<double> sample_ns, double outlier_mad_multiplier) -> bench_result
+    {
+        bench_result result;
+        result.name = std::move(name);
+        result.iterations = iterations;
+
+        if (sample_ns.empty())
+            return result;
+
+        std::vector<double> scratch(sample_ns);
+        auto median = detail::median_of(scratch);
+        auto mad = detail::median_absolute_deviation(sample_ns, median);
+
+        // 1.4826 scales the MAD to a standard deviation for normal data, a 0
+        // MAD gives a 0 limit and keeps only the tied samples
+        if (outlier_mad_multiplier > 0.0) {
+            const auto limit = outlier_mad_multiplier * 1.4826 * mad;
+            auto kept_end = std::remove_if(sample_ns.begin(), sample_ns.end(),
+                [median, limit](double x) { return std::abs(x - median) > limit; });
+            result.outliers = static_cast<std::size_t>(sample_ns.end() - kept_end);
+            sample_ns.erase(kept_end, sample_ns.end());
+
+            scratch = sample_ns;
+            median = detail::median_of(scratch);
+            mad = detail::median_absolute_deviation(sample_ns, median);
+        }
+
+        double sum = 0.0;
+        for (auto x : sample_ns) {
+            sum += x;
+        }
+
+        result.samples = sample_ns.size();
+        result.median_ns = median;
+        result.mad_ns = mad;
+        result.mean_ns = sum / static_cast<double>(sample_ns.size());
+        result.min_ns = *std::min_element(sample_ns.begin(), sample_ns.end());
+        result.max_ns = *std::max_element(sample_ns.begin(), sample_ns.end());
+        return result;
+    }
+
+    XHANALIB_INLINE auto to_json(const bench_result& result) -> std::string
+    {
+        std::ostringstream stream;
+        stream << "{\"name\":\"";
+        for (auto c : result.name) {
+            if (c == '"' || c == '\\') {
+                stream << '\\' << c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20) {
+                stream << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                    << static_cast<int>(c) << std::dec << std::setfill(' ');
+            }
+            else {
+                stream << c;
+            }
+        }
+        stream << "\",\"iterations\":" << result.iterations
+            << ",\"samples\":" << result.samples
+            << ",\"outliers\":" << result.outliers
+            << std::setprecision(17)
+            << ",\"median_ns\":" << result.median_ns
+            << ",\"mad_ns\":" << result.mad_ns
+            << ",\"mean_ns\":" << result.mean_ns
+            << ",\"min_ns\":" << result.min_ns
+            << ",\"max_ns\":" << result.max_ns << "}";
+        return stream.str();
+    }
+
+    XHANALIB_INLINE auto operator<<(std::ostream& os, const bench_result& result) -> std::ostream &
+    {
+        return os << result.name << " median " << result.median_ns << " ns +/- "
+            << result.mad_ns << " (MAD), mean " << result.mean_ns << " ns, "
+            << result.iterations << " iterations x " << result.samples << " samples, "
+            << result.outliers << " outliers";
+    }
+#endif
+}
+#endif
@@ -0,0 +1,35 @@
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// xhanalib/config.h
+//
+// Build mode switches shared by every xhanalib feature header.
+//
+// Header only (default): every function is defined inline in its header.
+// Compiled: define XHANALIB_COMPILED (the xhanalib::xhanalib_compiled CMake
+// target does this for you) and the non-template functions are only declared
+// in the headers, their definitions live in src/xhanalib.cpp. Headers then
+// only pull in what their declarations need.
+//
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#pragma once
+
+#ifndef INCLUDE_XHANALIB_CONFIG_H
+#define INCLUDE_XHANALIB_CONFIG_H
+
+#undef max
+
+#if defined(XHANALIB_COMPILED)
+#define XHANALIB_INLINE
+#else
+#define XHANALIB_INLINE inline
+#endif
+
+// True when the current translation unit should see function definitions:
+// always in header only mode, only in src/xhanalib.cpp in compiled mode.
+#if !defined(XHANALIB_COMPILED) || defined(XHANALIB_IMPLEMENTATION)
+#define XHANALIB_DEFINE_FUNCTIONS 1
+#else
+#define XHANALIB_DEFINE_FUNCTIONS 0
+#endif
+
+#endif
@@ -0,0 +1,99 @@
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// xhanalib/conversion.h
+//
+// String conversion and key/value helpers: xl::to_string,
+// xl::deserialize_key_value and xl::keyval.
+//
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#pragma once
+
+#ifndef INCLUDE_XHANALIB_CONVERSION_H
+#define INCLUDE_XHANALIB_CONVERSION_H
+
+#include "config.h"
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#if XHANALIB_DEFINE_FUNCTIONS
+#include <cstddef>
+#include <utility>
+#endif
+
+namespace xhanalib
+{
+    // Used for making data structures like:
+    //
+    // struct xl::keyval results_case_opts[] = {
+    //    {0, "upper"},
+    //    {1, "lower"},
+    //    {2, "mixed"}
+    // };
+    //
+    // Usage:
+    //   results_case_opts[p_case].value
+    struct keyval {
+        int key;
+        const char *value;
+    };
+
+    // Type neutral way to pull strings of numerics.
+    //
+    // Usage:
+    //   auto a = xl::to_string(1);
+    //   auto a = xl::to_string("1");
+    //   auto a = xl::to_string(1.2);
+    template <class T>
+	inline auto to_string (const T& t) -> std::string
+	{
+		std::stringstream ss;
+		ss << t;
+		return ss.str();
+	}
+
+    // Simple deserialize key value strings with element and item
+    // separators. (like with CGI param's)
+    // Usage:
+    //   auto a = "name=john&age=50";
+    //   std::map<std::string, std::string> m{};
+    //   if (xl::deserialize_key_value(s, '=', '&', m))
+    XHANALIB_INLINE auto deserialize_key_value(const std::string& in_str,
+        const char element_sep,
+        const char item_sep,
+        std::map<std::string, std::string>& out_map) -> bool;
+
+#if XHANALIB_DEFINE_FUNCTIONS
+    XHANALIB_INLINE auto deserialize_key_value(const std::string& in_str,
+        const char element_sep,
+        const char item_sep,
+        std::map<std::string, std::string>& out_map) -> bool
+    {
+        std::size_t begin{ 0 };
+        std::size_t end{ 0 };
+
+        while (begin < in_str.size()) {
+            // Search key
+            end = in_str.find(element_sep, begin);
+            if (end == std::string::npos)
+                return false;
+
+            auto key = in_str.substr(begin, /*size=*/ end - begin);
+            begin = end + 1;
+
+            // Search value
+            end = in_str.find(item_sep, begin);
+            auto value = in_str.substr(begin, end == std::string::npos ? std::string::npos : /*size=*/ end - begin);
+            begin = (end == std::string::npos) ? in_str.size() : end + 1;
+
+            // Store key-value
+            auto emplaceResult = out_map.emplace(std::move(key), std::move(value));
+            if (!emplaceResult.second)
+                return false;
+        }
+        return true;
+    }
+#endif
+}
+#endif
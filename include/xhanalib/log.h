@@ -0,0 +1,59 @@
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// xhanalib/log.h
+//
+// Logging shortcuts: xl::log, xl::log_once and the internal trace helper.
+//
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#pragma once
+
+#ifndef INCLUDE_XHANALIB_LOG_H
+#define INCLUDE_XHANALIB_LOG_H
+
+#include "config.h"
+
+#include <iostream>
+
+namespace xhanalib
+{
+    namespace detail
+    {
+        // If a test fails, enable trace logging for it to troubleshoot
+        // Assuming using acutest.h
+        template <typename T1, typename T2>
+        void TraceLog(T1 msg, T2 val, bool enableTraceLogging = false)
+        {
+            if (enableTraceLogging)
+            {
+                std::cout << msg << ":[" << val << "]\n";
+            }
+        }
+    }
+
+    // Shortcut to print "msg", value
+    // xl::log("The value is:", variable);
+    template <typename T1, typename T2>
+    auto log(T1 msg, T2 val) -> void
+    {
+        // Set to true to enable logging, false to disable
+        // Implement otherwise to suit your needs
+        constexpr bool enableLogging = true;
+
+        if constexpr (enableLogging)
+        {
+            std::cout << msg << ":[" << val << "]\n";
+        }
+    }
+
+    template <typename T1, typename T2, typename T3>
+    auto log_once(T1 msg, T2 val1, T3 val2) -> void
+    {
+        static bool hasBeenCalled = false;
+        if (!hasBeenCalled)
+        {
+            std::cout << msg << ":[" << val1 << "] " << "[" << val2 << "]\n";
+        }
+        hasBeenCalled = true;
+    }
+}
+#endif
@@ -0,0 +1,83 @@
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// xhanalib/numeric.h
+//
+// Number helpers: xl::count_digits, xl::equal_to_n_decimal_places and
+// xl::number_as_binary.
+//
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#pragma once
+
+#ifndef INCLUDE_XHANALIB_NUMERIC_H
+#define INCLUDE_XHANALIB_NUMERIC_H
+
+#include "config.h"
+
+#include <cstddef>
+#include <type_traits>
+
+#if XHANALIB_DEFINE_FUNCTIONS
+#include <cmath>
+#endif
+
+namespace xhanalib
+{
+    // Number of digits in a number.
+    //
+    // Usage:
+    //   auto number_of_digits_in_a_number = xl::count_digits(1234);
+    template <typename T>
+    static T count_digits(T number) 
+    {
+        static_assert(std::is_arithmetic<T>::value, "count_digits is numeric types only");
+        T count = 0;
+        while(number != 0) {
+            number = number / 10;
+            count++;
+        }
+        return count;
+    }
+
+    // Float or decimal comparison to n decimal places
+    //
+    // Usage:
+    //   if( TEST_CHECK( equal_to_n_decimal_places( c.circumference(), 94.2478f, 4) )) {
+    XHANALIB_INLINE bool equal_to_n_decimal_places(float a, float b, int decimal_places);
+
+    // Shorten just chops it in half if you only care about the right side.
+    template <typename T1>
+    auto number_as_binary(T1 num, bool shorten = true) -> const char *
+    {
+        static_assert(std::is_arithmetic<T1>::value, "number_as_binary is numeric types only");
+        static char buffer[sizeof(num) * 8 + 1]; // +1 for null terminator
+        size_t size = sizeof(num) * 8; // Number of bits in type
+
+        if (shorten)
+        {
+            size = size / 2;
+            for (int i = size - 1; i >= 0; i--) {
+                int bit = (num >> i) & 1;
+                buffer[size - i - 1] = '0' + bit;
+            }
+        }
+        else
+        { 
+            for (int i = size - 1; i >= 0; i--) {
+                int bit = (num >> i) & 1;
+                buffer[size - i - 1] = '0' + bit;
+            }
+        }
+
+        buffer[size] = '\0'; // Null terminator
+
+        return buffer;
+    }
+
+#if XHANALIB_DEFINE_FUNCTIONS
+    XHANALIB_INLINE bool equal_to_n_decimal_places(float a, float b, int decimal_places) {
+        float epsilon = std::pow(10, -decimal_places);
+        return std::abs(a - b) < epsilon;
+    }
+#endif
+}
+#endif
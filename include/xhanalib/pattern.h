@@ -0,0 +1,589 @@
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// xhanalib/pattern.h
+//
+// Random strings from regex like templates: xl::string_pattern and
+// xl::random_string_from_pattern.
+//
+// A pattern is compiled once into a flat program of instructions with its
+// alphabets stored inline, generating a string is then a walk over that
+// program writing into one buffer. Compilation happens at compile time only
+// for a constexpr string_pattern, a pattern passed as a string is compiled
+// at run time on every call.
+//
+// Syntax:
+//   abc         literal characters
+//   \. \\ \(    escaped literal, non alphanumeric characters only, \s or
+//               \n are an error rather than a literal letter
+//   [a-z0-9_]   character class, ranges allowed, [^...] negates over
+//               printable ASCII
+//   .           any printable ASCII character
+//   \d \w       [0-9] and [A-Za-z0-9_], also usable inside [...]
+//   (a|bc|d)    group with alternatives, a top level | works too
+//   {n} {n,m}   repeat the previous atom or group n, or n to m times
+//   ? * +       {0,1}, {0,pattern_unbounded_max}, {1,pattern_unbounded_max}
+//
+// Errors throw std::invalid_argument (bad syntax) or std::length_error
+// (pattern larger than the program capacity), a compile error when constexpr.
+//
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#pragma once
+
+#ifndef INCLUDE_XHANALIB_PATTERN_H
+#define INCLUDE_XHANALIB_PATTERN_H
+
+#include "config.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace xhanalib
+{
+    // Upper repeat count used for * and +
+    constexpr std::uint16_t pattern_unbounded_max = 8;
+
+    // Deepest nesting of quantified groups
+    constexpr std::size_t pattern_max_repeat_depth = 16;
+
+    // Most alternatives in a single group
+    constexpr std::size_t pattern_max_alternatives = 32;
+
+    enum class pattern_op : std::uint8_t {
+        literal,        // copy b chars from pool[a]
+        char_class,     // min..max chars picked from the b chars at pool[a]
+        alternation,    // jump to one of the b targets at targets[a]
+        jump,           // continue at a
+        repeat_begin,   // run the body min..max times, a is the repeat_end
+        repeat_end,     // loop back to a while repeats remain
+        end
+    };
+
+    struct pattern_instruction {
+        pattern_op op{ pattern_op::end };
+        std::uint16_t a{ 0 };
+        std::uint16_t b{ 0 };
+        std::uint16_t min{ 0 };
+        std::uint16_t max{ 0 };
+    };
+
+    // Compiled pattern with fixed capacity, so it can be built constexpr.
+    // Use a larger capacity for long patterns.
+    //
+    // Usage:
+    //   constexpr xl::string_pattern plate("[A-Z]{3}-[0-9]{4}");
+    //   std::mt19937_64 rg{ std::random_device{}() };
+    //   auto a = plate.generate(rg);                      // "QKD-0381"
+    //
+    //   std::string buffer;
+    //   plate.generate_n(buffer, 1000000, '\n', rg);      // bulk, one buffer
+    template <std::size_t MaxInstructions = 64, std::size_t MaxPoolChars = 1024>
+    class basic_string_pattern
+    {
+        static_assert(MaxInstructions <= std::numeric_limits<std::uint16_t>::max(), "MaxInstructions must fit 16 bits");
+        static_assert(MaxPoolChars <= std::numeric_limits<std::uint16_t>::max(), "MaxPoolChars must fit 16 bits");
+
+    public:
+        constexpr explicit basic_string_pattern(std::string_view pattern)
+            : pattern_(pattern)
+        {
+            max_length_ = parse_alternatives(0);
+            if (pos_ != pattern_.size()) {
+                throw std::invalid_argument("string_pattern: unmatched ')'");
+            }
+            emit(pattern_instruction{ pattern_op::end, 0, 0, 0, 0 });
+
+            // The source text is only needed while compiling and may not outlive us
+            pattern_ = std::string_view{};
+            pos_ = 0;
+        }
+
+        // Longest string the pattern can produce
+        constexpr auto max_length() const -> std::size_t { return max_length_; }
+
+        // Number of instructions in the compiled program
+        constexpr auto program_size() const -> std::size_t { return program_size_; }
+
+        constexpr auto instruction(std::size_t index) const -> const pattern_instruction & { return program_[index]; }
+
+        // Write one matching string to out, which must hold max_length()
+        // chars. Returns the number written, no null terminator.
+        // URBG must produce full range 64-bit values, e.g. std::mt19937_64.
+        template <typename URBG>
+        auto generate_into(char* out, URBG& rg) const -> std::size_t
+        {
+            static_assert(URBG::min() == 0 && URBG::max() == std::numeric_limits<std::uint64_t>::max(),
+                "string_pattern needs a 64-bit generator such as std::mt19937_64");
+
+            // Two 32-bit draws per 64-bit value, index = (draw * n) >> 32.
+            // Bias is below 2^-24 for alphabets up to 256 characters.
+            std::uint64_t bits = 0;
+            bool have_half = false;
+            auto pick = [&rg, &bits, &have_half](std::uint32_t n) -> std::uint32_t {
+                std::uint32_t half;
+                if (have_half) {
+                    half = static_cast<std::uint32_t>(bits >> 32);
+                    have_half = false;
+                }
+                else {
+                    bits = rg();
+                    half = static_cast<std::uint32_t>(bits);
+                    have_half = true;
+                }
+                return static_cast<std::uint32_t>((static_cast<std::uint64_t>(half) * n) >> 32);
+            };
+
+            std::array<std::uint16_t, pattern_max_repeat_depth> remaining{};
+            std::size_t depth = 0;
+            std::size_t length = 0;
+            std::size_t pc = 0;
+
+            for (;;) {
+                const auto& in = program_[pc];
+                switch (in.op) {
+                case pattern_op::literal:
+                    for (std::uint16_t i = 0; i < in.b; i++) {
+                        out[length++] = pool_[in.a + i];
+                    }
+                    pc++;
+                    break;
+                case pattern_op::char_class: {
+                    std::uint32_t count = in.min;
+                    if (in.max > in.min) {
+                        count += pick(static_cast<std::uint32_t>(in.max - in.min) + 1);
+                    }
+                    const char* alphabet = pool_.data() + in.a;
+                    for (std::uint32_t i = 0; i < count; i++) {
+                        out[length++] = alphabet[pick(in.b)];
+                    }
+                    pc++;
+                    break;
+                }
+                case pattern_op::alternation:
+                    pc = targets_[in.a + pick(in.b)];
+                    break;
+                case pattern_op::jump:
+                    pc = in.a;
+                    break;
+                case pattern_op::repeat_begin: {
+                    std::uint32_t count = in.min;
+                    if (in.max > in.min) {
+                        count += pick(static_cast<std::uint32_t>(in.max - in.min) + 1);
+                    }
+                    if (count == 0) {
+                        pc = static_cast<std::size_t>(in.a) + 1;
+                    }
+                    else {
+                        remaining[depth++] = static_cast<std::uint16_t>(count);
+                        pc++;
+                    }
+                    break;
+                }
+                case pattern_op::repeat_end:
+                    if (--remaining[depth - 1] > 0) {
+                        pc = in.a;
+                    }
+                    else {
+                        depth--;
+                        pc++;
+                    }
+                    break;
+                case pattern_op::end:
+                    return length;
+                }
+            }
+        }
+
+        template <typename URBG>
+        auto generate(URBG& rg) const -> std::string
+        {
+            std::string s(max_length_, '\0');
+            s.resize(generate_into(&s[0], rg));
+            return s;
+        }
+
+        // Append count strings to out, each followed by separator. Reserves
+        // once for the worst case, so out allocates at most one time.
+        template <typename URBG>
+        auto generate_n(std::string& out, std::size_t count, char separator, URBG& rg) const -> void
+        {
+            auto length = out.size();
+            out.resize(length + count * (max_length_ + 1));
+            for (std::size_t i = 0; i < count; i++) {
+                length += generate_into(&out[length], rg);
+                out[length++] = separator;
+            }
+            out.resize(length);
+        }
+
+    private:
+        constexpr auto peek() const -> char
+        {
+            return (pos_ < pattern_.size()) ? pattern_[pos_] : '\0';
+        }
+
+        constexpr auto at_end() const -> bool
+        {
+            return pos_ >= pattern_.size();
+        }
+
+        constexpr auto emit(pattern_instruction in) -> std::size_t
+        {
+            if (program_size_ >= MaxInstructions) {
+                throw std::length_error("string_pattern: too many instructions, raise MaxInstructions");
+            }
+            program_[program_size_] = in;
+            return program_size_++;
+        }
+
+        constexpr auto emit_char(char c) -> void
+        {
+            if (pool_size_ >= MaxPoolChars) {
+                throw std::length_error("string_pattern: alphabets too large, raise MaxPoolChars");
+            }
+            pool_[pool_size_++] = c;
+        }
+
+        // Alternatives up to ')' or the end, returns the longest length
+        constexpr auto parse_alternatives(std::size_t depth) -> std::size_t
+        {
+            const auto alternation = emit(pattern_instruction{ pattern_op::jump, 0, 0, 0, 0 });
+
+            std::array<std::size_t, pattern_max_alternatives> starts{};
+            std::array<std::size_t, pattern_max_alternatives> jumps{};
+            std::size_t count = 0;
+            std::size_t longest = 0;
+
+            for (;;) {
+                if (count == pattern_max_alternatives) {
+                    throw std::length_error("string_pattern: too many alternatives in a group");
+                }
+                starts[count] = program_size_;
+                const auto length = parse_sequence(depth);
+                longest = (length > longest) ? length : longest;
+                count++;
+
+                if (peek() != '|') {
+                    break;
+                }
+                pos_++;
+                jumps[count - 1] = emit(pattern_instruction{ pattern_op::jump, 0, 0, 0, 0 });
+            }
+
+            const auto end = static_cast<std::uint16_t>(program_size_);
+            for (std::size_t i = 0; i + 1 < count; i++) {
+                program_[jumps[i]].a = end;
+            }
+
+            if (count == 1) {
+                // Plain sequence, the placeholder just falls through
+                program_[alternation].a = static_cast<std::uint16_t>(alternation + 1);
+            }
+            else {
+                if (targets_size_ + count > targets_.size()) {
+                    throw std::length_error("string_pattern: too many alternatives, raise MaxInstructions");
+                }
+                program_[alternation] = pattern_instruction{ pattern_op::alternation,
+                    static_cast<std::uint16_t>(targets_size_), static_cast<std::uint16_t>(count), 0, 0 };
+                for (std::size_t i = 0; i < count; i++) {
+                    targets_[targets_size_++] = static_cast<std::uint16_t>(starts[i]);
+                }
+            }
+
+            // What follows the group must not extend a literal inside it,
+            // earlier alternatives jump past that instruction
+            merge_floor_ = program_size_;
+            return longest;
+        }
+
+        constexpr auto parse_sequence(std::size_t depth) -> std::size_t
+        {
+            std::size_t length = 0;
+            while (!at_end() && peek() != '|' && peek() != ')') {
+                length += parse_atom(depth);
+            }
+            return length;
+        }
+
+        constexpr auto parse_atom(std::size_t depth) -> std::size_t
+        {
+            const char c = pattern_[pos_++];
+
+            if (c == '(') {
+                const auto slot = emit(pattern_instruction{ pattern_op::jump, 0, 0, 0, 0 });
+                auto length = parse_alternatives(depth + 1);
+                if (peek() != ')') {
+                    throw std::invalid_argument("string_pattern: missing ')'");
+                }
+                pos_++;
+
+                std::uint16_t min = 1;
+                std::uint16_t max = 1;
+                if (parse_quantifier(min, max)) {
+                    if (depth + 1 > pattern_max_repeat_depth) {
+                        throw std::length_error("string_pattern: quantified groups nested too deep");
+                    }
+                    const auto repeat_end = emit(pattern_instruction{ pattern_op::repeat_end,
+                        static_cast<std::uint16_t>(slot + 1), 0, 0, 0 });
+                    program_[slot] = pattern_instruction{ pattern_op::repeat_begin,
+                        static_cast<std::uint16_t>(repeat_end), 0, min, max };
+                    length *= max;
+                }
+                else {
+                    program_[slot].a = static_cast<std::uint16_t>(slot + 1);
+                }
+                return length;
+            }
+
+            if (c == '[' || c == '.' || (c == '\\' && (peek() == 'd' || peek() == 'w'))) {
+                std::array<bool, 256> set{};
+                if (c == '[') {
+                    parse_class(set);
+                }
+                else if (c == '.') {
+                    add_range(set, ' ', '~');
+                }
+                else {
+                    add_escape_class(set, pattern_[pos_++]);
+                }
+                return emit_class(set);
+            }
+
+            if (c == '{' || c == '}' || c == '?' || c == '*' || c == '+') {
+                throw std::invalid_argument("string_pattern: quantifier without something to repeat");
+            }
+
+            char literal = c;
+            if (c == '\\') {
+                literal = parse_escaped();
+            }
+
+            std::uint16_t min = 1;
+            std::uint16_t max = 1;
+            if (parse_quantifier(min, max)) {
+                const auto offset = static_cast<std::uint16_t>(pool_size_);
+                emit_char(literal);
+                emit(pattern_instruction{ pattern_op::char_class, offset, 1, min, max });
+                return max;
+            }
+
+            // Extend the previous literal when its chars end the pool and it
+            // is not inside a group closed since
+            if (program_size_ > merge_floor_) {
+                auto& last = program_[program_size_ - 1];
+                if (last.op == pattern_op::literal && last.a + last.b == pool_size_) {
+                    emit_char(literal);
+                    last.b++;
+                    return 1;
+                }
+            }
+            const auto offset = static_cast<std::uint16_t>(pool_size_);
+            emit_char(literal);
+            emit(pattern_instruction{ pattern_op::literal, offset, 1, 0, 0 });
+            return 1;
+        }
+
+        // After the '[', through the closing ']'
+        constexpr auto parse_class(std::array<bool, 256>& set) -> void
+        {
+            bool negate = false;
+            if (peek() == '^') {
+                negate = true;
+                pos_++;
+            }
+
+            bool first = true;
+            while (!at_end() && (peek() != ']' || first)) {
+                first = false;
+                char lo = pattern_[pos_++];
+                if (lo == '\\') {
+                    if (peek() == 'd' || peek() == 'w') {
+                        add_escape_class(set, pattern_[pos_++]);
+                        continue;
+                    }
+                    lo = parse_escaped();
+                }
+
+                char hi = lo;
+                if (peek() == '-' && pos_ + 1 < pattern_.size() && pattern_[pos_ + 1] != ']') {
+                    pos_++;
+                    hi = pattern_[pos_++];
+                    if (hi == '\\') {
+                        hi = parse_escaped();
+                    }
+                    if (static_cast<unsigned char>(hi) < static_cast<unsigned char>(lo)) {
+                        throw std::invalid_argument("string_pattern: reversed range in '[...]'");
+                    }
+                }
+                add_range(set, lo, hi);
+            }
+
+            if (at_end()) {
+                throw std::invalid_argument("string_pattern: missing ']'");
+            }
+            pos_++;
+
+            if (negate) {
+                for (std::size_t i = 0; i < set.size(); i++) {
+                    set[i] = !set[i] && i >= static_cast<std::size_t>(' ') && i <= static_cast<std::size_t>('~');
+                }
+            }
+        }
+
+        // After a '\\' outside of \d and \w, the escaped character. Letters
+        // and digits would read as regex escapes (\s, \n, \D) that mean
+        // something else, so they are rejected.
+        constexpr auto parse_escaped() -> char
+        {
+            if (at_end()) {
+                throw std::invalid_argument("string_pattern: pattern ends with '\\'");
+            }
+            const char c = pattern_[pos_++];
+            if ((c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) {
+                throw std::invalid_argument("string_pattern: unknown escape");
+            }
+            return c;
+        }
+
+        static constexpr auto add_range(std::array<bool, 256>& set, char lo, char hi) -> void
+        {
+            for (auto i = static_cast<std::size_t>(static_cast<unsigned char>(lo));
+                i <= static_cast<std::size_t>(static_cast<unsigned char>(hi)); i++) {
+                set[i] = true;
+            }
+        }
+
+        static constexpr auto add_escape_class(std::array<bool, 256>& set, char escape) -> void
+        {
+            add_range(set, '0', '9');
+            if (escape == 'w') {
+                add_range(set, 'A', 'Z');
+                add_range(set, 'a', 'z');
+                set[static_cast<std::size_t>('_')] = true;
+            }
+        }
+
+        // Class alphabet into the pool in byte order, with its quantifier
+        constexpr auto emit_class(const std::array<bool, 256>& set) -> std::size_t
+        {
+            const auto offset = static_cast<std::uint16_t>(pool_size_);
+            for (std::size_t i = 0; i < set.size(); i++) {
+                if (set[i]) {
+                    emit_char(static_cast<char>(i));
+                }
+            }
+            const auto size = static_cast<std::uint16_t>(pool_size_ - offset);
+            if (size == 0) {
+                throw std::invalid_argument("string_pattern: empty character class");
+            }
+
+            std::uint16_t min = 1;
+            std::uint16_t max = 1;
+            parse_quantifier(min, max);
+            emit(pattern_instruction{ pattern_op::char_class, offset, size, min, max });
+            return max;
+        }
+
+        constexpr auto parse_number() -> std::uint16_t
+        {
+            if (peek() < '0' || peek() > '9') {
+                throw std::invalid_argument("string_pattern: expected a number in '{}'");
+            }
+            std::uint32_t value = 0;
+            while (peek() >= '0' && peek() <= '9') {
+                value = value * 10 + static_cast<std::uint32_t>(pattern_[pos_++] - '0');
+                if (value > std::numeric_limits<std::uint16_t>::max()) {
+                    throw std::invalid_argument("string_pattern: repeat count too large");
+                }
+            }
+            return static_cast<std::uint16_t>(value);
+        }
+
+        // Optional quantifier after an atom, returns false when there is none
+        constexpr auto parse_quantifier(std::uint16_t& min, std::uint16_t& max) -> bool
+        {
+            switch (peek()) {
+            case '?':
+                pos_++;
+                min = 0;
+                max = 1;
+                return true;
+            case '*':
+                pos_++;
+                min = 0;
+                max = pattern_unbounded_max;
+                return true;
+            case '+':
+                pos_++;
+                min = 1;
+                max = pattern_unbounded_max;
+                return true;
+            case '{':
+                pos_++;
+                min = parse_number();
+                max = min;
+                if (peek() == ',') {
+                    pos_++;
+                    max = parse_number();
+                }
+                if (peek() != '}') {
+                    throw std::invalid_argument("string_pattern: missing '}'");
+                }
+                pos_++;
+                if (max < min) {
+                    throw std::invalid_argument("string_pattern: {n,m} with m < n");
+                }
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        std::string_view pattern_;
+        std::size_t pos_{ 0 };
+
+        std::array<pattern_instruction, MaxInstructions> program_{};
+        std::array<char, MaxPoolChars> pool_{};
+        std::array<std::uint16_t, MaxInstructions> targets_{};
+        std::size_t program_size_{ 0 };
+        std::size_t pool_size_{ 0 };
+        std::size_t targets_size_{ 0 };
+        std::size_t merge_floor_{ 0 };
+        std::size_t max_length_{ 0 };
+    };
+
+    using string_pattern = basic_string_pattern<>;
+
+    // One random string matching a compiled pattern
+    //
+    // Usage:
+    //   constexpr xl::string_pattern email("user_[a-z0-9]{8}@example\\.(com|org)");
+    //   auto a = xl::random_string_from_pattern(email);
+    template <std::size_t MaxInstructions, std::size_t MaxPoolChars>
+    auto random_string_from_pattern(const basic_string_pattern<MaxInstructions, MaxPoolChars>& pattern) -> std::string
+    {
+        thread_local static std::mt19937_64 rg{ std::random_device{}() };
+        return pattern.generate(rg);
+    }
+
+    // Compiles pattern at run time on every call. For compile time
+    // compilation and syntax checks use a constexpr string_pattern and the
+    // overload above.
+    //
+    // Usage:
+    //   auto a = xl::random_string_from_pattern("[A-Z]{3}-[0-9]{4}");
+    XHANALIB_INLINE auto random_string_from_pattern(std::string_view pattern) -> std::string;
+
+#if XHANALIB_DEFINE_FUNCTIONS
+    XHANALIB_INLINE auto random_string_from_pattern(std::string_view pattern) -> std::string
+    {
+        return random_string_from_pattern(string_pattern(pattern));
+    }
+#endif
+}
+#endif
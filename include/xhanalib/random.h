@@ -0,0 +1,168 @@
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// xhanalib/random.h
+//
+// Random data generation: xl::random_integer_from_range_x_to_y,
+// xl::random_real_from_range_x_to_y, xl::random_number_of_length_n and
+// xl::random_string_of_length_n.
+//
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#pragma once
+
+#ifndef INCLUDE_XHANALIB_RANDOM_H
+#define INCLUDE_XHANALIB_RANDOM_H
+
+#include "config.h"
+#include "log.h"
+#include "numeric.h"
+
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace xhanalib
+{
+    // Specify an integer type and the lower and upper bound inclusive
+    template <typename T1>
+    auto random_integer_from_range_x_to_y( T1 lower_boundary, 
+        T1 upper_boundary ) -> T1
+    {
+        static_assert(std::is_arithmetic<T1>::value, "random_integer_from_range_x_to_y is numeric types only");
+        constexpr bool traceLoggingEnabled = false;
+
+        // Seed the random number generator with a truly random value
+        std::random_device rd;
+
+        // Create a Mersenne Twister engine and seed it with the random device
+        std::mt19937 gen(rd());
+
+        // Create a uniform_int_distribution using the desired range
+        std::uniform_int_distribution<T1> distribution(lower_boundary, upper_boundary);
+
+        // Generate a random integer using the distribution and the random number generator
+        T1 result_num = distribution(gen);
+
+        // Output the generated random integer
+        detail::TraceLog("Random number:", result_num, traceLoggingEnabled);
+
+        return result_num;
+    }
+    
+    // Can specify float, double or long double
+    template <typename T1>
+    auto random_real_from_range_x_to_y( T1 lower_boundary, 
+        T1 upper_boundary) -> T1
+	{
+        static_assert(std::is_arithmetic<T1>::value, "random_real_from_range_x_to_y is numeric types only");
+        constexpr bool traceLoggingEnabled = false;
+        std::random_device rd;
+        std::mt19937 gen(rd());
+        std::uniform_real_distribution<T1> distribution(lower_boundary, upper_boundary);
+        float result_num = distribution(gen);
+        detail::TraceLog("Random number:", result_num, traceLoggingEnabled);
+        return result_num;
+    }
+    
+    // Request a random number of length n.
+	// Number must be one digit shorter than max value of type.
+	// Throws std::out_of_range if not shorter.
+	// Ex.
+	// auto a = random_number_of_length_n<int>(4);  // Get a random 4 digit integer
+	template <typename T1>
+	auto random_number_of_length_n( size_t length_of_number ) -> T1
+	{
+        static_assert(std::is_arithmetic<T1>::value, "random_number_of_length_n is numeric types only");
+        constexpr bool traceLoggingEnabled = false;
+		T1 return_num = 0;
+
+		// Throw if size of type chosen isn't one digit shorter than size requested
+		detail::TraceLog("max value for (T1)", std::numeric_limits<T1>::max(), traceLoggingEnabled);
+		size_t max_digits_of_type = count_digits<T1>( std::numeric_limits<T1>::max() );
+		if(max_digits_of_type > length_of_number && length_of_number > 0)
+		{
+			// This is okay
+		}
+		else
+		{
+			throw std::out_of_range("Digits of requested number must be one less than type used.");
+		}
+		detail::TraceLog("digits in type:", max_digits_of_type, traceLoggingEnabled);
+		detail::TraceLog("digits requested:", length_of_number, traceLoggingEnabled);
+		
+		const std::string dist_chars {"1234567890"};
+		std::string::size_type length_of_rndstring = length_of_number;
+        thread_local static std::mt19937_64 rg{ std::random_device{}() };
+        std::string s;
+        s.reserve(length_of_rndstring);
+        std::uniform_int_distribution<std::string::size_type> pick(0, dist_chars.length() - 1);
+
+        while (length_of_rndstring--)
+        {
+			// Need to skip 0 if it is the first one
+			if((length_of_number-1)==length_of_rndstring)
+			{
+				do
+				{
+					s = dist_chars[pick(rg)];
+					detail::TraceLog("In do while", s, traceLoggingEnabled);
+				} while (s == "0");
+			}
+			else
+			{
+				s += dist_chars[pick(rg)];
+				detail::TraceLog("Appended to s", s, traceLoggingEnabled);
+			}
+        }
+		std::stringstream ss_for_num(s);
+		ss_for_num >> return_num;
+
+        return return_num;
+    }
+
+    // Pass in: Length of requested string, characters to choose from
+    // https://stackoverflow.com/questions/440133/how-do-i-create-a-random-alpha-numeric-string-in-c
+    XHANALIB_INLINE auto random_string_of_length_n(std::string::size_type length_of_rndstring,
+        const std::string& dist_chars) -> std::string;
+
+#if XHANALIB_DEFINE_FUNCTIONS
+    XHANALIB_INLINE auto random_string_of_length_n(std::string::size_type length_of_rndstring,
+        const std::string& dist_chars) -> std::string
+    {
+        /*
+        Pseudo-random number engines (instantiations)
+        default_random_engine   Default random engine (class )
+        minstd_rand             Minimal Standard minstd_rand generator (class )
+        minstd_rand0            Minimal Standard minstd_rand0 generator (class )
+        mt19937                 Mersenne Twister 19937 generator (class )
+        mt19937_64              Mersenne Twister 19937 generator (64 bit) (class )
+        ranlux24_base           Ranlux 24 base generator (class )
+        ranlux48_base           Ranlux 48 base generator (class )
+        ranlux24                Ranlux 24 generator (class )
+        ranlux48                Ranlux 48 generator (class )
+        knuth_b                 Knuth-B generator (class )
+        */
+
+        //thread_local static std::mt19937 rg{std::random_device{}()};
+        thread_local static std::mt19937_64 rg{ std::random_device{}() };
+        //thread_local static std::knuth_b rg{std::random_device{}()};
+        //thread_local static std::ranlux48 rg{std::random_device{}()};
+
+        // Note: Don't do thread local static on uniform_int_dist if variable length items
+        //thread_local static std::uniform_int_distribution<std::string::size_type> pick(0, dist_chars.length() - 1);
+        std::uniform_int_distribution<std::string::size_type> pick(0, dist_chars.length() - 1);
+
+        std::string s;
+        s.reserve(length_of_rndstring);
+        while (length_of_rndstring--)
+        {
+            s += dist_chars[pick(rg)];
+        }
+
+        return s;
+    }
+#endif
+}
+#endif
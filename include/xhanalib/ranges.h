@@ -0,0 +1,516 @@
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// xhanalib/ranges.h
+//
+// Lazy random value streams: xl::random_ints, xl::random_reals and
+// xl::random_strings.
+//
+// A range owns its generator and produces values on demand, so streams of
+// any length run in constant memory. Iterate it, limit it with take(n),
+// pull chunks with next_batch(), or under C++20 wrap it in a coroutine with
+// xl::as_generator().
+//
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#pragma once
+
+#ifndef INCLUDE_XHANALIB_RANGES_H
+#define INCLUDE_XHANALIB_RANGES_H
+
+#include "config.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#include <exception>
+#define XHANALIB_HAS_COROUTINES 1
+#endif
+
+namespace xhanalib
+{
+    // Sentinel ending every random_range iteration
+    struct random_range_end {};
+
+    // Input iterator over random_range and random_take_view, reads the
+    // range's current value and draws the next one on ++
+    template <typename Range>
+    class random_range_iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = typename Range::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+
+        random_range_iterator() = default;
+        explicit random_range_iterator(Range* range) : range_(range) {}
+
+        auto operator*() const -> reference { return range_->current(); }
+        auto operator->() const -> pointer { return &range_->current(); }
+
+        auto operator++() -> random_range_iterator &
+        {
+            range_->advance();
+            return *this;
+        }
+
+        auto operator++(int) -> void { ++*this; }
+
+        friend auto operator==(const random_range_iterator& it, random_range_end) -> bool { return !it.range_->has_current(); }
+        friend auto operator!=(const random_range_iterator& it, random_range_end) -> bool { return it.range_->has_current(); }
+        friend auto operator==(random_range_end, const random_range_iterator& it) -> bool { return !it.range_->has_current(); }
+        friend auto operator!=(random_range_end, const random_range_iterator& it) -> bool { return it.range_->has_current(); }
+
+    private:
+        Range* range_{ nullptr };
+    };
+
+    template <typename Range>
+    class random_take_view;
+
+    // Input range of random values drawn from Source. Iterating or pulling
+    // batches consumes the stream, begin() continues where the last pull
+    // stopped. Unbounded until take(n) is applied, and a value counts
+    // against take(n) once begin() or ++ draws it, so the iterator and
+    // next_batch() share one budget.
+    //
+    // take(n) on a temporary bounds the range itself. On a named range it
+    // returns a random_take_view drawing from that range, so taking twice
+    // continues the stream instead of replaying it.
+    //
+    // Source provides value_type and operator()(URBG&, value_type&), which
+    // assigns a new value in place so strings keep their capacity.
+    template <typename Source>
+    class random_range
+    {
+    public:
+        using value_type = typename Source::value_type;
+        using iterator = random_range_iterator<random_range>;
+
+        explicit random_range(Source source)
+            : source_(std::move(source)), engine_(std::random_device{}())
+        {
+        }
+
+        // Same range with a fixed seed, for reproducible streams
+        auto with_seed(std::uint64_t seed) const -> random_range
+        {
+            random_range copy(*this);
+            copy.engine_.seed(seed);
+            return copy;
+        }
+
+        // At most n more values from this range's stream
+        auto take(std::size_t n) & -> random_take_view<random_range>
+        {
+            return random_take_view<random_range>(*this, n);
+        }
+
+        // This range limited to at most n more values
+        auto take(std::size_t n) && -> random_range
+        {
+            remaining_ = (n < remaining_) ? n : remaining_;
+            bounded_ = true;
+            return std::move(*this);
+        }
+
+        // Values left, std::numeric_limits<std::size_t>::max() when unbounded
+        auto remaining() const -> std::size_t { return remaining_; }
+
+        // True while an iterator points at a drawn value
+        auto has_current() const -> bool { return has_current_; }
+
+        // Draws a fresh value, one already seen through an iterator is spent
+        auto begin() -> iterator
+        {
+            advance();
+            return iterator(this);
+        }
+
+        auto end() const -> random_range_end { return {}; }
+
+        // Next value into out, false once the range is exhausted
+        auto next(value_type& out) -> bool
+        {
+            return next_batch(&out, 1) == 1;
+        }
+
+        // Fill up to n values at out, returns how many were written (less
+        // than n only when take() runs out). Existing values are assigned
+        // over, so reusing a buffer of strings does not allocate.
+        auto next_batch(value_type* out, std::size_t n) -> std::size_t
+        {
+            n = (n < remaining_) ? n : remaining_;
+            for (std::size_t i = 0; i < n; i++) {
+                source_(engine_, out[i]);
+            }
+            if (bounded_) {
+                remaining_ -= n;
+            }
+            return n;
+        }
+
+        // Fill a contiguous container, e.g. std::vector or std::array
+        template <typename Container>
+        auto next_batch(Container& out) -> std::size_t
+        {
+            return next_batch(std::data(out), std::size(out));
+        }
+
+    private:
+        friend class random_range_iterator<random_range>;
+
+        auto current() const -> const value_type & { return current_; }
+
+        auto advance() -> void
+        {
+            has_current_ = remaining_ > 0;
+            if (has_current_) {
+                source_(engine_, current_);
+                if (bounded_) {
+                    remaining_--;
+                }
+            }
+        }
+
+        Source source_;
+        std::mt19937_64 engine_;
+        value_type current_{};
+        std::size_t remaining_{ std::numeric_limits<std::size_t>::max() };
+        bool bounded_{ false };
+        bool has_current_{ false };
+    };
+
+    // At most n values drawn from a range owned elsewhere, returned by
+    // take(n) on a named range. Values come out of that range's stream and
+    // budget, so the range must outlive the view.
+    template <typename Range>
+    class random_take_view
+    {
+    public:
+        using value_type = typename Range::value_type;
+        using iterator = random_range_iterator<random_take_view>;
+
+        random_take_view(Range& range, std::size_t n) : range_(&range), remaining_(n) {}
+
+        auto take(std::size_t n) & -> random_take_view<random_take_view>
+        {
+            return random_take_view<random_take_view>(*this, n);
+        }
+
+        auto take(std::size_t n) && -> random_take_view
+        {
+            remaining_ = (n < remaining_) ? n : remaining_;
+            return std::move(*this);
+        }
+
+        // Values left in this view, the underlying range may run out first
+        auto remaining() const -> std::size_t { return remaining_; }
+
+        auto has_current() const -> bool { return has_current_; }
+
+        auto begin() -> iterator
+        {
+            advance();
+            return iterator(this);
+        }
+
+        auto end() const -> random_range_end { return {}; }
+
+        auto next(value_type& out) -> bool
+        {
+            return next_batch(&out, 1) == 1;
+        }
+
+        auto next_batch(value_type* out, std::size_t n) -> std::size_t
+        {
+            n = range_->next_batch(out, (n < remaining_) ? n : remaining_);
+            remaining_ -= n;
+            return n;
+        }
+
+        template <typename Container>
+        auto next_batch(Container& out) -> std::size_t
+        {
+            return next_batch(std::data(out), std::size(out));
+        }
+
+    private:
+        friend class random_range_iterator<random_take_view>;
+
+        auto current() const -> const value_type & { return current_; }
+
+        auto advance() -> void
+        {
+            has_current_ = remaining_ > 0 && range_->next(current_);
+            if (has_current_) {
+                remaining_--;
+            }
+        }
+
+        Range* range_;
+        value_type current_{};
+        std::size_t remaining_;
+        bool has_current_{ false };
+    };
+
+    struct take_adaptor {
+        std::size_t count;
+    };
+
+    // range | xl::take(n), same as range.take(n)
+    constexpr auto take(std::size_t n) -> take_adaptor
+    {
+        return take_adaptor{ n };
+    }
+
+    template <typename Source>
+    auto operator|(random_range<Source>& range, take_adaptor adaptor) -> random_take_view<random_range<Source>>
+    {
+        return range.take(adaptor.count);
+    }
+
+    template <typename Source>
+    auto operator|(random_range<Source>&& range, take_adaptor adaptor) -> random_range<Source>
+    {
+        return std::move(range).take(adaptor.count);
+    }
+
+    template <typename Range>
+    auto operator|(random_take_view<Range>& view, take_adaptor adaptor) -> random_take_view<random_take_view<Range>>
+    {
+        return view.take(adaptor.count);
+    }
+
+    template <typename Range>
+    auto operator|(random_take_view<Range>&& view, take_adaptor adaptor) -> random_take_view<Range>
+    {
+        return std::move(view).take(adaptor.count);
+    }
+
+    namespace detail
+    {
+        template <typename T>
+        struct random_int_source {
+            using value_type = T;
+            std::uniform_int_distribution<T> distribution;
+
+            template <typename URBG>
+            auto operator()(URBG& rg, T& out) -> void { out = distribution(rg); }
+        };
+
+        template <typename T>
+        struct random_real_source {
+            using value_type = T;
+            std::uniform_real_distribution<T> distribution;
+
+            template <typename URBG>
+            auto operator()(URBG& rg, T& out) -> void { out = distribution(rg); }
+        };
+
+        // Two characters per 64-bit draw, index = (half * size) >> 32.
+        // Bias is below 2^-24 for alphabets up to 256 characters.
+        struct random_string_source {
+            using value_type = std::string;
+            std::size_t length;
+            std::string alphabet;
+
+            template <typename URBG>
+            auto operator()(URBG& rg, std::string& out) -> void
+            {
+                out.resize(length);
+                const auto size = static_cast<std::uint64_t>(alphabet.size());
+                std::size_t i = 0;
+                for (; i + 1 < length; i += 2) {
+                    const std::uint64_t bits = rg();
+                    out[i] = alphabet[((bits & 0xffffffff) * size) >> 32];
+                    out[i + 1] = alphabet[((bits >> 32) * size) >> 32];
+                }
+                if (i < length) {
+                    out[i] = alphabet[((rg() & 0xffffffff) * size) >> 32];
+                }
+            }
+        };
+    }
+
+    // Integers in [lower_boundary, upper_boundary], like random_integer_from_range_x_to_y
+    //
+    // Usage:
+    //   for (auto v : xl::random_ints(1, 6).take(10))
+    //       xl::log("roll", v);
+    template <typename T1>
+    auto random_ints(T1 lower_boundary, T1 upper_boundary) -> random_range<detail::random_int_source<T1>>
+    {
+        static_assert(std::is_integral<T1>::value, "random_ints is integer types only");
+        return random_range<detail::random_int_source<T1>>(
+            detail::random_int_source<T1>{ std::uniform_int_distribution<T1>(lower_boundary, upper_boundary) });
+    }
+
+    // Reals in [lower_boundary, upper_boundary), like random_real_from_range_x_to_y
+    //
+    // Usage:
+    //   std::vector<double> chunk(4096);
+    //   auto reals = xl::random_reals(0.0, 1.0);
+    //   while (reals.next_batch(chunk) > 0) consume(chunk);
+    template <typename T1>
+    auto random_reals(T1 lower_boundary, T1 upper_boundary) -> random_range<detail::random_real_source<T1>>
+    {
+        static_assert(std::is_floating_point<T1>::value, "random_reals is float, double or long double only");
+        return random_range<detail::random_real_source<T1>>(
+            detail::random_real_source<T1>{ std::uniform_real_distribution<T1>(lower_boundary, upper_boundary) });
+    }
+
+    // Strings of length_of_rndstring picked from dist_chars, like
+    // random_string_of_length_n. Throws std::invalid_argument on an empty
+    // dist_chars.
+    //
+    // Usage:
+    //   for (const auto& s : xl::random_strings(8, "abcdef") | xl::take(1000))
+    //       consume(s);
+    XHANALIB_INLINE auto random_strings(std::string::size_type length_of_rndstring,
+        std::string dist_chars) -> random_range<detail::random_string_source>;
+
+#if defined(XHANALIB_HAS_COROUTINES)
+    // Minimal C++20 coroutine generator, yields references to values owned
+    // by the coroutine frame
+    template <typename T>
+    class generator
+    {
+    public:
+        struct promise_type {
+            const T* value{ nullptr };
+            std::exception_ptr exception;
+
+            auto get_return_object() -> generator
+            {
+                return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+            auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+            auto final_suspend() noexcept -> std::suspend_always { return {}; }
+            auto yield_value(const T& v) noexcept -> std::suspend_always
+            {
+                value = &v;
+                return {};
+            }
+            auto return_void() noexcept -> void {}
+            auto unhandled_exception() -> void { exception = std::current_exception(); }
+        };
+
+        class iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T *;
+            using reference = const T &;
+
+            iterator() = default;
+            explicit iterator(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+            auto operator*() const -> reference { return *handle_.promise().value; }
+            auto operator->() const -> pointer { return handle_.promise().value; }
+
+            auto operator++() -> iterator &
+            {
+                handle_.resume();
+                rethrow();
+                return *this;
+            }
+
+            auto operator++(int) -> void { ++*this; }
+
+            auto rethrow() const -> void
+            {
+                if (handle_.done() && handle_.promise().exception) {
+                    std::rethrow_exception(handle_.promise().exception);
+                }
+            }
+
+            friend auto operator==(const iterator& it, std::default_sentinel_t) -> bool { return it.handle_.done(); }
+
+        private:
+            std::coroutine_handle<promise_type> handle_{};
+        };
+
+        generator(generator&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+        generator(const generator&) = delete;
+        auto operator=(const generator&) -> generator & = delete;
+        auto operator=(generator&& other) noexcept -> generator &
+        {
+            if (this != &other) {
+                if (handle_) {
+                    handle_.destroy();
+                }
+                handle_ = std::exchange(other.handle_, {});
+            }
+            return *this;
+        }
+
+        ~generator()
+        {
+            if (handle_) {
+                handle_.destroy();
+            }
+        }
+
+        auto begin() -> iterator
+        {
+            handle_.resume();
+            iterator it(handle_);
+            it.rethrow();
+            return it;
+        }
+
+        auto end() const -> std::default_sentinel_t { return {}; }
+
+    private:
+        explicit generator(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    // Coroutine over a random range or take view, ends when the range does
+    //
+    // Usage:
+    //   for (int v : xl::as_generator(xl::random_ints(1, 6) | xl::take(10)))
+    //       xl::log("roll", v);
+    template <typename Range>
+    auto as_generator(Range range) -> generator<typename Range::value_type>
+    {
+        typename Range::value_type value{};
+        while (range.next(value)) {
+            co_yield value;
+        }
+    }
+
+    // A named range is drawn from, not copied, like take() on it
+    template <typename Source>
+    auto as_generator(random_range<Source>& range) -> generator<typename Source::value_type>
+    {
+        return as_generator(range.take(std::numeric_limits<std::size_t>::max()));
+    }
+#endif
+
+#if XHANALIB_DEFINE_FUNCTIONS
+    XHANALIB_INLINE auto random_strings(std::string::size_type length_of_rndstring,
+        std::string dist_chars) -> random_range<detail::random_string_source>
+    {
+        if (dist_chars.empty()) {
+            throw std::invalid_argument("random_strings needs at least one character to pick from");
+        }
+        return random_range<detail::random_string_source>(
+            detail::random_string_source{ length_of_rndstring, std::move(dist_chars) });
+    }
+#endif
+}
+#endif
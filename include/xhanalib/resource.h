@@ -0,0 +1,347 @@
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// xhanalib/resource.h
+//
+// Native process resource accounting: xl::resource_usage,
+// xl::sample_resource_usage, xl::resource_scope and xl::resource_sampler.
+//
+// Reads getrusage() and, on Linux, /proc/self/stat, status and io directly
+// into stack buffers. No shell, no allocation per sample.
+//
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#pragma once
+
+#ifndef INCLUDE_XHANALIB_RESOURCE_H
+#define INCLUDE_XHANALIB_RESOURCE_H
+
+#include "config.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if XHANALIB_DEFINE_FUNCTIONS
+#include <cstring>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+#endif
+
+namespace xhanalib
+{
+    // One sample of the current process. Fields a platform can't provide
+    // stay 0 (/proc values are Linux only, nothing is sampled on Windows).
+    // Signed so a delta of two samples can go negative, e.g. rss_bytes.
+    struct resource_usage {
+        std::int64_t timestamp_ns;                  // steady_clock
+        std::int64_t user_cpu_us;                   // getrusage
+        std::int64_t system_cpu_us;                 // getrusage
+        std::int64_t rss_bytes;                     // status VmRSS
+        std::int64_t peak_rss_bytes;                // status VmHWM, else ru_maxrss
+        std::int64_t minor_faults;                  // getrusage
+        std::int64_t major_faults;                  // getrusage
+        std::int64_t voluntary_context_switches;    // getrusage
+        std::int64_t involuntary_context_switches;  // getrusage
+        std::int64_t threads;                       // stat num_threads
+        std::int64_t read_chars;                    // io rchar, read() and friends
+        std::int64_t write_chars;                   // io wchar, write() and friends
+        std::int64_t read_bytes;                    // io read_bytes, fetched from storage
+        std::int64_t write_bytes;                   // io write_bytes, sent to storage
+    };
+
+    // Fill out with the current process usage.
+    // Returns false if nothing could be sampled (unsupported platform).
+    //
+    // Usage:
+    //   xl::resource_usage u{};
+    //   if (xl::sample_resource_usage(u))
+    //       xl::log("rss", u.rss_bytes);
+    XHANALIB_INLINE auto sample_resource_usage(resource_usage& out) -> bool;
+
+    // Field by field after - before
+    XHANALIB_INLINE auto resource_usage_delta(const resource_usage& before,
+        const resource_usage& after) -> resource_usage;
+
+    // Snapshot at construction, delta() against the current usage.
+    //
+    // Usage:
+    //   xl::resource_scope scope;
+    //   code_under_test();
+    //   auto d = scope.delta();
+    //   xl::log("cpu us", d.user_cpu_us + d.system_cpu_us);
+    class resource_scope
+    {
+    public:
+        XHANALIB_INLINE resource_scope();
+
+        XHANALIB_INLINE auto start() const -> const resource_usage &;
+        XHANALIB_INLINE auto delta() const -> resource_usage;
+
+    private:
+        resource_usage start_{};
+    };
+
+    // Background thread sampling every interval into a time series.
+    // Storage for reserve_samples is allocated up front, the vector only
+    // grows (and allocates) past that. Read samples() after stop().
+    //
+    // Usage:
+    //   xl::resource_sampler sampler(std::chrono::milliseconds(10));
+    //   sampler.start();
+    //   code_under_test();
+    //   sampler.stop();
+    //   for (const auto& s : sampler.samples()) ...
+    class resource_sampler
+    {
+    public:
+        XHANALIB_INLINE explicit resource_sampler(std::chrono::milliseconds interval,
+            std::size_t reserve_samples = 1024);
+        XHANALIB_INLINE ~resource_sampler();
+
+        resource_sampler(const resource_sampler&) = delete;
+        resource_sampler& operator=(const resource_sampler&) = delete;
+
+        // Takes a first sample and starts the thread, no-op if running
+        XHANALIB_INLINE auto start() -> void;
+        // Takes a last sample and joins the thread, no-op if not running
+        XHANALIB_INLINE auto stop() -> void;
+
+        XHANALIB_INLINE auto samples() const -> const std::vector<resource_usage> &;
+
+    private:
+        XHANALIB_INLINE auto record() -> void;
+
+        std::chrono::milliseconds interval_;
+        std::vector<resource_usage> samples_;
+        std::thread thread_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        bool running_{ false };
+    };
+
+#if XHANALIB_DEFINE_FUNCTIONS
+    namespace detail
+    {
+#if defined(__linux__)
+        // Read a whole /proc file into buf, null terminated. Returns length or -1.
+        inline auto read_proc_file(const char* path, char* buf, std::size_t size) -> long
+        {
+            int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                return -1;
+
+            std::size_t used = 0;
+            while (used < size - 1) {
+                auto n = ::read(fd, buf + used, size - 1 - used);
+                if (n <= 0)
+                    break;
+                used += static_cast<std::size_t>(n);
+            }
+            ::close(fd);
+            buf[used] = '\0';
+            return static_cast<long>(used);
+        }
+
+        // Parse a decimal number at p, skipping leading blanks, advance p past it
+        inline auto parse_int64(const char*& p) -> std::int64_t
+        {
+            while (*p == ' ' || *p == '\t')
+                ++p;
+            bool negative = (*p == '-');
+            if (negative)
+                ++p;
+            std::int64_t value = 0;
+            while (*p >= '0' && *p <= '9')
+                value = value * 10 + (*p++ - '0');
+            return negative ? -value : value;
+        }
+
+        // Value of a "Key: value" line, 0 when not present
+        inline auto find_key_value(const char* buf, const char* key) -> std::int64_t
+        {
+            const auto key_length = std::strlen(key);
+            for (const char* line = buf; *line != '\0'; ) {
+                if (std::strncmp(line, key, key_length) == 0) {
+                    const char* p = line + key_length;
+                    return parse_int64(p);
+                }
+                line = std::strchr(line, '\n');
+                if (line == nullptr)
+                    break;
+                ++line;
+            }
+            return 0;
+        }
+#endif
+    }
+
+    XHANALIB_INLINE auto sample_resource_usage(resource_usage& out) -> bool
+    {
+        out = resource_usage{};
+        out.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+
+        bool sampled = false;
+
+#if defined(__unix__) || defined(__APPLE__)
+        struct rusage usage;
+        if (::getrusage(RUSAGE_SELF, &usage) == 0) {
+            out.user_cpu_us = static_cast<std::int64_t>(usage.ru_utime.tv_sec) * 1000000 + usage.ru_utime.tv_usec;
+            out.system_cpu_us = static_cast<std::int64_t>(usage.ru_stime.tv_sec) * 1000000 + usage.ru_stime.tv_usec;
+#if defined(__APPLE__)
+            out.peak_rss_bytes = usage.ru_maxrss;          // bytes on macOS
+#else
+            out.peak_rss_bytes = usage.ru_maxrss * 1024;   // kB elsewhere
+#endif
+            out.minor_faults = usage.ru_minflt;
+            out.major_faults = usage.ru_majflt;
+            out.voluntary_context_switches = usage.ru_nvcsw;
+            out.involuntary_context_switches = usage.ru_nivcsw;
+            sampled = true;
+        }
+#endif
+
+#if defined(__linux__)
+        char buf[4096];
+
+        if (detail::read_proc_file("/proc/self/status", buf, sizeof(buf)) > 0) {
+            out.rss_bytes = detail::find_key_value(buf, "VmRSS:") * 1024;
+            auto peak = detail::find_key_value(buf, "VmHWM:") * 1024;
+            if (peak > 0)
+                out.peak_rss_bytes = peak;
+            sampled = true;
+        }
+
+        // Count fields from the ")" closing comm (field 2), the comm itself
+        // may hold spaces. num_threads is field 20.
+        if (detail::read_proc_file("/proc/self/stat", buf, sizeof(buf)) > 0) {
+            const char* p = std::strrchr(buf, ')');
+            if (p != nullptr) {
+                ++p;
+                for (int field = 2; field < 20 && *p != '\0'; ++p) {
+                    if (*p == ' ')
+                        ++field;
+                }
+                out.threads = detail::parse_int64(p);
+            }
+        }
+
+        // May be missing or unreadable (kernel config, ptrace restrictions)
+        if (detail::read_proc_file("/proc/self/io", buf, sizeof(buf)) > 0) {
+            out.read_chars = detail::find_key_value(buf, "rchar:");
+            out.write_chars = detail::find_key_value(buf, "wchar:");
+            out.read_bytes = detail::find_key_value(buf, "read_bytes:");
+            out.write_bytes = detail::find_key_value(buf, "write_bytes:");
+        }
+#endif
+
+        return sampled;
+    }
+
+    XHANALIB_INLINE auto resource_usage_delta(const resource_usage& before,
+        const resource_usage& after) -> resource_usage
+    {
+        resource_usage d;
+        d.timestamp_ns = after.timestamp_ns - before.timestamp_ns;
+        d.user_cpu_us = after.user_cpu_us - before.user_cpu_us;
+        d.system_cpu_us = after.system_cpu_us - before.system_cpu_us;
+        d.rss_bytes = after.rss_bytes - before.rss_bytes;
+        d.peak_rss_bytes = after.peak_rss_bytes - before.peak_rss_bytes;
+        d.minor_faults = after.minor_faults - before.minor_faults;
+        d.major_faults = after.major_faults - before.major_faults;
+        d.voluntary_context_switches = after.voluntary_context_switches - before.voluntary_context_switches;
+        d.involuntary_context_switches = after.involuntary_context_switches - before.involuntary_context_switches;
+        d.threads = after.threads - before.threads;
+        d.read_chars = after.read_chars - before.read_chars;
+        d.write_chars = after.write_chars - before.write_chars;
+        d.read_bytes = after.read_bytes - before.read_bytes;
+        d.write_bytes = after.write_bytes - before.write_bytes;
+        return d;
+    }
+
+    XHANALIB_INLINE resource_scope::resource_scope()
+    {
+        sample_resource_usage(start_);
+    }
+
+    XHANALIB_INLINE auto resource_scope::start() const -> const resource_usage &
+    {
+        return start_;
+    }
+
+    XHANALIB_INLINE auto resource_scope::delta() const -> resource_usage
+    {
+        resource_usage now;
+        sample_resource_usage(now);
+        return resource_usage_delta(start_, now);
+    }
+
+    XHANALIB_INLINE resource_sampler::resource_sampler(std::chrono::milliseconds interval,
+        std::size_t reserve_samples)
+        : interval_(interval)
+    {
+        samples_.reserve(reserve_samples);
+    }
+
+    XHANALIB_INLINE resource_sampler::~resource_sampler()
+    {
+        stop();
+    }
+
+    XHANALIB_INLINE auto resource_sampler::start() -> void
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (running_)
+                return;
+            running_ = true;
+        }
+        record();
+
+        thread_ = std::thread([this] {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (running_) {
+                if (wake_.wait_for(lock, interval_, [this] { return !running_; }))
+                    break;
+                lock.unlock();
+                record();
+                lock.lock();
+            }
+        });
+    }
+
+    XHANALIB_INLINE auto resource_sampler::stop() -> void
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_)
+                return;
+            running_ = false;
+        }
+        wake_.notify_all();
+        thread_.join();
+        record();
+    }
+
+    XHANALIB_INLINE auto resource_sampler::samples() const -> const std::vector<resource_usage> &
+    {
+        return samples_;
+    }
+
+    XHANALIB_INLINE auto resource_sampler::record() -> void
+    {
+        resource_usage sample;
+        sample_resource_usage(sample);
+        std::lock_guard<std::mutex> lock(mutex_);
+        samples_.push_back(sample);
+    }
+#endif
+}
+#endif
@@ -0,0 +1,71 @@
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// xhanalib/system.h
+//
+// Process helpers: xl::execute and xl::pause_for_enter.
+//
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#pragma once
+
+#ifndef INCLUDE_XHANALIB_SYSTEM_H
+#define INCLUDE_XHANALIB_SYSTEM_H
+
+#include "config.h"
+
+#include <string>
+
+#if XHANALIB_DEFINE_FUNCTIONS
+#include <array>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+namespace
+{
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
+    constexpr auto &pipe_open_stream = _popen;
+    constexpr auto &pipe_close_stream = _pclose;
+#else
+    constexpr auto &pipe_open_stream = popen;
+    constexpr auto &pipe_close_stream = pclose;
+#endif
+}
+#endif
+
+namespace xhanalib
+{
+    // System call, return output as string
+    [[nodiscard]] XHANALIB_INLINE auto execute(const char* cmd) -> std::string;
+
+    // Cross platform pause for enter
+    XHANALIB_INLINE auto pause_for_enter() -> void;
+
+#if XHANALIB_DEFINE_FUNCTIONS
+    [[nodiscard]] XHANALIB_INLINE auto execute(const char* cmd) -> std::string 
+    {
+        std::string result;
+        std::array<char, 128> buffer;
+
+        std::unique_ptr<FILE, decltype(&pipe_close_stream)> pipe(pipe_open_stream(cmd, "r"), 
+            pipe_close_stream);
+
+        if (!pipe) {
+            throw std::runtime_error("popen() failed!");
+        }
+
+        while (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) {
+            result += buffer.data();
+        }
+
+        return result;
+    }
+
+    XHANALIB_INLINE auto pause_for_enter() -> void {
+        std::cout << "Press Enter to continue...";
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+#endif
+}
+#endif
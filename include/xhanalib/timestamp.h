@@ -0,0 +1,55 @@
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// xhanalib/timestamp.h
+//
+// Wall clock helpers: xl::get_current_timestamp.
+//
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#pragma once
+
+#ifndef INCLUDE_XHANALIB_TIMESTAMP_H
+#define INCLUDE_XHANALIB_TIMESTAMP_H
+
+#include "config.h"
+
+#include <string>
+
+#if XHANALIB_DEFINE_FUNCTIONS
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#endif
+
+namespace xhanalib
+{
+    // Return timestamp with milliseconds as a std:string
+    // Format: 23:47:24.805
+    XHANALIB_INLINE auto get_current_timestamp() -> std::string;
+
+#if XHANALIB_DEFINE_FUNCTIONS
+    XHANALIB_INLINE auto get_current_timestamp() -> std::string
+    {
+        using namespace std::chrono;
+        using clock = system_clock;
+        struct tm timeinfo;
+
+        const auto current_time_point{ clock::now() };
+        const auto current_time{ clock::to_time_t(current_time_point) };
+        
+#ifdef _WIN32
+        localtime_s(&timeinfo, &current_time);
+#else
+        localtime_r(&current_time, &timeinfo);
+#endif
+
+        const auto current_time_since_epoch{ current_time_point.time_since_epoch() };
+        const auto current_milliseconds{ duration_cast<milliseconds> (current_time_since_epoch).count() % 1000 };
+
+        std::ostringstream stream;
+        stream << std::put_time(&timeinfo, "%T") << "." << std::setw(3) << std::setfill('0') << current_milliseconds;
+        return stream.str();
+    }
+#endif
+}
+#endif
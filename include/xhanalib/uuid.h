@@ -0,0 +1,352 @@
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// xhanalib/uuid.h
+//
+// Unique identifiers in bulk: RFC 9562 UUIDv4 and UUIDv7, and ULID.
+//
+// Generators fill arrays of xl::id128 from 64-bit draws (two per id).
+// UUIDv7 and ULID are monotonic across threads within a process so ids sort
+// in generation order. Formatting is separate from generation, hex uses
+// SSE2 on x86-64 and a lookup table elsewhere.
+//
+// Random bits come from a per thread mt19937_64 whose whole state is seeded
+// from std::random_device, so collisions between generators are as unlikely
+// as the random_device entropy allows. It is not a CSPRNG as RFC 9562 asks:
+// ids are unique, not unguessable, don't use them as secrets or tokens.
+//
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#pragma once
+
+#ifndef INCLUDE_XHANALIB_UUID_H
+#define INCLUDE_XHANALIB_UUID_H
+
+#include "config.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#if XHANALIB_DEFINE_FUNCTIONS
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <random>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define XHANALIB_UUID_SSE2 1
+#endif
+#endif
+
+namespace xhanalib
+{
+    // 128-bit identifier, big endian byte order as in RFC 9562
+    using id128 = std::array<std::uint8_t, 16>;
+
+    // Canonical text lengths, no null terminator
+    constexpr std::size_t uuid_string_length = 36;   // 8-4-4-4-12 hex
+    constexpr std::size_t ulid_string_length = 26;   // Crockford base32
+
+    // Fill out[0..count) with random version 4 UUIDs
+    XHANALIB_INLINE auto generate_uuid_v4(id128* out, std::size_t count) -> void;
+
+    // Fill out[0..count) with version 7 UUIDs: 48-bit unix ms timestamp,
+    // then a 42-bit counter (rand_a and the top of rand_b) seeded randomly
+    // each millisecond, then 32 random bits. Strictly increasing across
+    // calls and threads in this process.
+    XHANALIB_INLINE auto generate_uuid_v7(id128* out, std::size_t count) -> void;
+
+    // Fill out[0..count) with monotonic ULIDs: 48-bit unix ms timestamp and
+    // 80 random bits, incremented by one for ids in the same millisecond.
+    XHANALIB_INLINE auto generate_ulid(id128* out, std::size_t count) -> void;
+
+    // Write uuid_string_length chars per id, ids back to back, no separator
+    //
+    // Usage:
+    //   std::vector<xl::id128> ids(1000);
+    //   xl::generate_uuid_v7(ids.data(), ids.size());
+    //   std::string text(ids.size() * xl::uuid_string_length, '\0');
+    //   xl::format_uuids(ids.data(), ids.size(), text.data());
+    XHANALIB_INLINE auto format_uuids(const id128* ids, std::size_t count, char* out) -> void;
+
+    // Write ulid_string_length chars per id, ids back to back, no separator
+    XHANALIB_INLINE auto format_ulids(const id128* ids, std::size_t count, char* out) -> void;
+
+    // One id as a string
+    //
+    // Usage:
+    //   auto a = xl::uuid_v4();   // "0f8fad5b-d9cb-469f-a165-70867728950e"
+    //   auto b = xl::uuid_v7();
+    //   auto c = xl::ulid();      // "01ARZ3NDEKTSV4RRFFQ69G5FAV"
+    XHANALIB_INLINE auto uuid_v4() -> std::string;
+    XHANALIB_INLINE auto uuid_v7() -> std::string;
+    XHANALIB_INLINE auto ulid() -> std::string;
+
+#if XHANALIB_DEFINE_FUNCTIONS
+    namespace detail
+    {
+        // Seeded with a full state's worth of random_device words, one
+        // 32-bit seed would allow only 2^32 distinct id streams
+        inline auto seeded_id_random_engine() -> std::mt19937_64
+        {
+            std::array<std::uint32_t, std::mt19937_64::state_size * 2> words;
+            std::random_device rd;
+            for (auto& word : words) {
+                word = rd();
+            }
+            std::seed_seq seq(words.begin(), words.end());
+            return std::mt19937_64(seq);
+        }
+
+        inline auto id_random_engine() -> std::mt19937_64 &
+        {
+            thread_local static std::mt19937_64 rg = seeded_id_random_engine();
+            return rg;
+        }
+
+        inline auto unix_time_ms() -> std::uint64_t
+        {
+            using namespace std::chrono;
+            return static_cast<std::uint64_t>(
+                duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count());
+        }
+
+        inline auto store_big_endian(std::uint64_t value, std::uint8_t* out) -> void
+        {
+            for (int i = 7; i >= 0; i--) {
+                out[i] = static_cast<std::uint8_t>(value);
+                value >>= 8;
+            }
+        }
+
+        // Process wide last timestamp and counter, shared by all threads.
+        // Callers reserve a run of counter values under the lock and fill
+        // their ids outside of it.
+        struct monotonic_id_state {
+            std::mutex mutex;
+            std::uint64_t last_ms{ 0 };
+            std::uint64_t next_hi{ 0 };     // counter, or random high bits for ULID
+            std::uint64_t next_lo{ 0 };
+        };
+
+        inline auto uuid_v7_state() -> monotonic_id_state &
+        {
+            static monotonic_id_state state;
+            return state;
+        }
+
+        inline auto ulid_state() -> monotonic_id_state &
+        {
+            static monotonic_id_state state;
+            return state;
+        }
+    }
+
+    XHANALIB_INLINE auto generate_uuid_v4(id128* out, std::size_t count) -> void
+    {
+        auto& rg = detail::id_random_engine();
+        for (std::size_t i = 0; i < count; i++) {
+            auto* bytes = out[i].data();
+            detail::store_big_endian(rg(), bytes);
+            detail::store_big_endian(rg(), bytes + 8);
+            bytes[6] = static_cast<std::uint8_t>((bytes[6] & 0x0f) | 0x40);   // version 4
+            bytes[8] = static_cast<std::uint8_t>((bytes[8] & 0x3f) | 0x80);   // variant 10
+        }
+    }
+
+    XHANALIB_INLINE auto generate_uuid_v7(id128* out, std::size_t count) -> void
+    {
+        constexpr int counter_bits = 42;
+        constexpr std::uint64_t counter_limit = std::uint64_t{ 1 } << counter_bits;
+
+        auto& rg = detail::id_random_engine();
+        auto& state = detail::uuid_v7_state();
+
+        while (count > 0) {
+            std::uint64_t ms;
+            std::uint64_t counter;
+            std::size_t run;
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                const auto now = detail::unix_time_ms();
+                if (now > state.last_ms) {
+                    state.last_ms = now;
+                    // Random start, top bit clear so a millisecond has room to count
+                    state.next_hi = rg() >> (64 - counter_bits + 1);
+                }
+                else if (state.next_hi >= counter_limit) {
+                    // Counter exhausted, borrow the next millisecond
+                    state.last_ms++;
+                    state.next_hi = rg() >> (64 - counter_bits + 1);
+                }
+                ms = state.last_ms;
+                counter = state.next_hi;
+                const auto available = counter_limit - counter;
+                run = (count < available) ? count : static_cast<std::size_t>(available);
+                state.next_hi += run;
+            }
+
+            for (std::size_t i = 0; i < run; i++, counter++) {
+                const auto random_bits = rg();
+                // ms(48) ver(4) counter_hi(12) | var(2) counter_lo(30) random(32)
+                const auto hi = (ms << 16) | (std::uint64_t{ 0x7 } << 12) | (counter >> 30);
+                const auto lo = (std::uint64_t{ 0x2 } << 62) | ((counter & 0x3fffffff) << 32)
+                    | (random_bits & 0xffffffff);
+                detail::store_big_endian(hi, out->data());
+                detail::store_big_endian(lo, out->data() + 8);
+                out++;
+            }
+            count -= run;
+        }
+    }
+
+    XHANALIB_INLINE auto generate_ulid(id128* out, std::size_t count) -> void
+    {
+        auto& rg = detail::id_random_engine();
+        auto& state = detail::ulid_state();
+
+        std::uint64_t ms;
+        std::uint64_t hi16;
+        std::uint64_t lo64;
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            const auto now = detail::unix_time_ms();
+            if (now > state.last_ms) {
+                state.last_ms = now;
+                state.next_hi = rg() & 0xffff;
+                state.next_lo = rg();
+            }
+            ms = state.last_ms;
+            hi16 = state.next_hi;
+            lo64 = state.next_lo;
+
+            // Reserve count values of the 80-bit random part, carrying into
+            // the timestamp if it runs out
+            const auto new_lo = lo64 + count;
+            state.next_hi += (new_lo < lo64) ? 1 : 0;
+            state.next_lo = new_lo;
+            if (state.next_hi > 0xffff) {
+                state.next_hi &= 0xffff;
+                state.last_ms++;
+            }
+        }
+
+        for (std::size_t i = 0; i < count; i++) {
+            detail::store_big_endian((ms << 16) | hi16, out->data());
+            detail::store_big_endian(lo64, out->data() + 8);
+            out++;
+
+            if (++lo64 == 0 && ++hi16 > 0xffff) {
+                hi16 = 0;
+                ms++;
+            }
+        }
+    }
+
+    XHANALIB_INLINE auto format_uuids(const id128* ids, std::size_t count, char* out) -> void
+    {
+        for (std::size_t n = 0; n < count; n++) {
+            const auto* bytes = ids[n].data();
+            char hex[32];
+
+#if defined(XHANALIB_UUID_SSE2)
+            // Split every byte into its two nibbles, interleave them in output
+            // order and map 0-9 to '0'-'9' and 10-15 to 'a'-'f'
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+            const __m128i low_mask = _mm_set1_epi8(0x0f);
+            const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi16(v, 4), low_mask);
+            const __m128i lo_nibbles = _mm_and_si128(v, low_mask);
+            const __m128i first = _mm_unpacklo_epi8(hi_nibbles, lo_nibbles);
+            const __m128i second = _mm_unpackhi_epi8(hi_nibbles, lo_nibbles);
+
+            const __m128i nine = _mm_set1_epi8(9);
+            const __m128i zero_char = _mm_set1_epi8('0');
+            const __m128i letter_offset = _mm_set1_epi8('a' - '0' - 10);
+            const __m128i first_hex = _mm_add_epi8(_mm_add_epi8(first, zero_char),
+                _mm_and_si128(_mm_cmpgt_epi8(first, nine), letter_offset));
+            const __m128i second_hex = _mm_add_epi8(_mm_add_epi8(second, zero_char),
+                _mm_and_si128(_mm_cmpgt_epi8(second, nine), letter_offset));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(hex), first_hex);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(hex + 16), second_hex);
+#else
+            static constexpr char digits[] = "0123456789abcdef";
+            for (int i = 0; i < 16; i++) {
+                hex[i * 2] = digits[bytes[i] >> 4];
+                hex[i * 2 + 1] = digits[bytes[i] & 0x0f];
+            }
+#endif
+
+            std::memcpy(out, hex, 8);
+            out[8] = '-';
+            std::memcpy(out + 9, hex + 8, 4);
+            out[13] = '-';
+            std::memcpy(out + 14, hex + 12, 4);
+            out[18] = '-';
+            std::memcpy(out + 19, hex + 16, 4);
+            out[23] = '-';
+            std::memcpy(out + 24, hex + 20, 12);
+            out += uuid_string_length;
+        }
+    }
+
+    XHANALIB_INLINE auto format_ulids(const id128* ids, std::size_t count, char* out) -> void
+    {
+        // Crockford base32, no I L O U
+        static constexpr char digits[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+
+        for (std::size_t n = 0; n < count; n++) {
+            const auto* bytes = ids[n].data();
+            std::uint64_t hi = 0;
+            std::uint64_t lo = 0;
+            for (int i = 0; i < 8; i++) {
+                hi = (hi << 8) | bytes[i];
+                lo = (lo << 8) | bytes[i + 8];
+            }
+
+            // 130 bits of output for 128 bits of input, the first char holds
+            // the top 3 bits. Low 64 bits fill the last 12 chars plus 4 bits
+            // of char 13, which also takes the low bit of hi.
+            for (int i = 25; i >= 14; i--) {
+                out[i] = digits[lo & 0x1f];
+                lo >>= 5;
+            }
+            out[13] = digits[(lo & 0x0f) | ((hi & 0x01) << 4)];
+            hi >>= 1;
+            for (int i = 12; i >= 0; i--) {
+                out[i] = digits[hi & 0x1f];
+                hi >>= 5;
+            }
+            out += ulid_string_length;
+        }
+    }
+
+    XHANALIB_INLINE auto uuid_v4() -> std::string
+    {
+        id128 id;
+        generate_uuid_v4(&id, 1);
+        std::string s(uuid_string_length, '\0');
+        format_uuids(&id, 1, &s[0]);
+        return s;
+    }
+
+    XHANALIB_INLINE auto uuid_v7() -> std::string
+    {
+        id128 id;
+        generate_uuid_v7(&id, 1);
+        std::string s(uuid_string_length, '\0');
+        format_uuids(&id, 1, &s[0]);
+        return s;
+    }
+
+    XHANALIB_INLINE auto ulid() -> std::string
+    {
+        id128 id;
+        generate_ulid(&id, 1);
+        std::string s(ulid_string_length, '\0');
+        format_ulids(&id, 1, &s[0]);
+        return s;
+    }
+#endif
+}
+#endif
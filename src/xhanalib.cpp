@@ -0,0 +1,11 @@
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// src/xhanalib.cpp
+//
+// Out of line definitions for the xhanalib::xhanalib_compiled target.
+// Consumers of that target get XHANALIB_COMPILED and only see declarations
+// for the non-template functions, this is the one place they are defined.
+//
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#define XHANALIB_IMPLEMENTATION
+#include "xhanalib.h"
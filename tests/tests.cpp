@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include "xhanalib.h"
@@ -5,6 +6,12 @@
 
 namespace xl = xhanalib;
 
+// Defined in tests_second_tu.cpp
+auto second_tu_platform_name() -> const char *;
+auto second_tu_deserialize_key_value(const std::string& in_str,
+    std::map<std::string, std::string>& out_map) -> bool;
+auto second_tu_timestamp() -> std::string;
+
 //
 // Compile and run:
 // g++ -std=c++17 -I../third_party/ test.cpp -o test.exe && ./test.exe
@@ -296,6 +303,446 @@ void test_equal_to_n_decimal_places_3(void)
     TEST_CHECK( xl::equal_to_n_decimal_places( 94.25f, 94.26f, 2) == false );
 }
 
+// Same functions used from two translation units link and agree
+void test_second_translation_unit_1(void)
+{
+    TEST_CHECK( strcmp( second_tu_platform_name(), xl::get_platform_name() ) == 0 );
+
+    std::map<std::string, std::string> out_map{};
+    TEST_CHECK( second_tu_deserialize_key_value("name=john&age=50", out_map) );
+    TEST_CHECK( out_map["age"] == "50" );
+
+    auto a = second_tu_timestamp();
+    TEST_CHECK_( a.length() == 12, "-> timestamp value:[%s]", a.c_str() );
+}
+
+// Native resource sample of this process
+void test_sample_resource_usage_1(void)
+{
+    xl::resource_usage u{};
+    auto sampled = xl::sample_resource_usage(u);
+#ifdef _WIN32
+    TEST_CHECK( sampled == false );
+#else
+    TEST_CHECK( sampled );
+    TEST_CHECK_( u.peak_rss_bytes > 0, "-> peak rss:[%lld]", (long long)u.peak_rss_bytes );
+#endif
+#ifdef __linux__
+    TEST_CHECK_( u.rss_bytes > 0, "-> rss:[%lld]", (long long)u.rss_bytes );
+    TEST_CHECK_( u.threads > 0, "-> threads:[%lld]", (long long)u.threads );
+#endif
+}
+
+// Delta around a scope that burns some cpu
+void test_resource_scope_1(void)
+{
+    xl::resource_scope scope;
+
+    // Spin for 20ms of wall time so the cpu clocks have to move
+    const auto spin_end = std::chrono::steady_clock::now() + std::chrono::milliseconds(20);
+    unsigned long long sum = 0;
+    while (std::chrono::steady_clock::now() < spin_end) {
+        for (int i = 0; i < 1000; i++) {
+            sum += i;
+            xl::do_not_optimize(sum);
+        }
+    }
+
+    auto d = scope.delta();
+    TEST_CHECK_( d.timestamp_ns >= 20000000, "-> elapsed ns:[%lld]", (long long)d.timestamp_ns );
+#ifndef _WIN32
+    TEST_CHECK_( d.user_cpu_us + d.system_cpu_us > 0, "-> cpu us:[%lld]", (long long)(d.user_cpu_us + d.system_cpu_us) );
+#endif
+}
+
+// Background sampler records a time series, first and last sample included
+void test_resource_sampler_1(void)
+{
+    xl::resource_sampler sampler(std::chrono::milliseconds(5));
+    sampler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sampler.stop();
+
+    const auto& samples = sampler.samples();
+    TEST_CHECK_( samples.size() >= 2, "-> samples:[%zu]", samples.size() );
+    TEST_CHECK( samples.back().timestamp_ns >= samples.front().timestamp_ns );
+}
+
+// Quick bench options so the suite stays fast
+static xl::bench_options quick_bench_options()
+{
+    xl::bench_options options;
+    options.warmup = std::chrono::milliseconds(1);
+    options.sample_time = std::chrono::microseconds(200);
+    options.samples = 5;
+    options.log_result = false;
+    return options;
+}
+
+void test_bench_1(void)
+{
+    auto r = xl::bench("to_string", [] { return xl::to_string(12345); }, quick_bench_options());
+    TEST_CHECK( r.name == "to_string" );
+    TEST_CHECK_( r.iterations > 0, "-> iterations:[%llu]", (unsigned long long)r.iterations );
+    TEST_CHECK( r.samples + r.outliers == 5 );
+    TEST_CHECK_( r.median_ns > 0.0, "-> median ns:[%f]", r.median_ns );
+}
+
+// Setup runs every iteration, fn gets its result
+void test_bench_with_setup_1(void)
+{
+    int setups = 0;
+    int calls = 0;
+    auto r = xl::bench_with_setup("setup",
+        [&setups] { return ++setups; },
+        [&calls](int& state) { calls++; return state; },
+        quick_bench_options());
+    TEST_CHECK( setups == calls && calls > 0 );
+    TEST_CHECK( r.samples > 0 );
+}
+
+// Median 3, MAD 1, 100 is rejected as an outlier
+void test_summarize_bench_samples_1(void)
+{
+    auto r = xl::summarize_bench_samples("stats", 10, {1.0, 2.0, 3.0, 4.0, 5.0, 100.0}, 3.0);
+    TEST_CHECK( r.outliers == 1 && r.samples == 5 );
+    TEST_CHECK_( r.median_ns == 3.0, "-> median:[%f]", r.median_ns );
+    TEST_CHECK_( r.mad_ns == 1.0, "-> mad:[%f]", r.mad_ns );
+    TEST_CHECK( r.min_ns == 1.0 && r.max_ns == 5.0 && r.mean_ns == 3.0 );
+
+    // Tied samples give a 0 MAD, the odd one out is still rejected
+    auto tied = xl::summarize_bench_samples("tied", 1, {5.0, 5.0, 5.0, 5.0, 100.0}, 3.0);
+    TEST_CHECK( tied.outliers == 1 && tied.samples == 4 );
+    TEST_CHECK_( tied.mean_ns == 5.0 && tied.max_ns == 5.0, "-> mean:[%f]", tied.mean_ns );
+
+    auto kept = xl::summarize_bench_samples("kept", 1, {5.0, 5.0, 5.0, 5.0, 100.0}, 0.0);
+    TEST_CHECK( kept.outliers == 0 && kept.samples == 5 );
+}
+
+void test_bench_to_json_1(void)
+{
+    auto r = xl::summarize_bench_samples("a\"b", 1, {2.0}, 3.0);
+    auto json = xl::to_json(r);
+    TEST_CHECK_( json.rfind("{\"name\":\"a\\\"b\",\"iterations\":1,", 0) == 0, "-> json:[%s]", json.c_str() );
+    TEST_CHECK( json.find("\"median_ns\":2") != std::string::npos );
+}
+
+// Version 4 and variant 10 land in the right hex digits
+void test_uuid_v4_1(void)
+{
+    auto a = xl::uuid_v4();
+    TEST_CHECK_( a.length() == 36, "-> uuid:[%s]", a.c_str() );
+    TEST_CHECK_( a[8] == '-' && a[13] == '-' && a[18] == '-' && a[23] == '-', "-> uuid:[%s]", a.c_str() );
+    TEST_CHECK_( a[14] == '4', "-> uuid:[%s]", a.c_str() );
+    TEST_CHECK_( strchr("89ab", a[19]) != NULL, "-> uuid:[%s]", a.c_str() );
+}
+
+// Bulk v7 ids are strictly increasing, version 7
+void test_uuid_v7_1(void)
+{
+    std::vector<xl::id128> ids(10000);
+    xl::generate_uuid_v7(ids.data(), ids.size() / 2);
+    xl::generate_uuid_v7(ids.data() + ids.size() / 2, ids.size() / 2);
+
+    bool increasing = true;
+    for (size_t i = 1; i < ids.size(); i++) {
+        increasing = increasing && ids[i - 1] < ids[i];
+    }
+    TEST_CHECK( increasing );
+    TEST_CHECK( (ids[0][6] >> 4) == 7 && (ids[0][8] >> 6) == 2 );
+
+    auto a = xl::uuid_v7();
+    TEST_CHECK_( a[14] == '7', "-> uuid:[%s]", a.c_str() );
+}
+
+void test_ulid_1(void)
+{
+    std::vector<xl::id128> ids(1000);
+    xl::generate_ulid(ids.data(), ids.size());
+
+    bool increasing = true;
+    for (size_t i = 1; i < ids.size(); i++) {
+        increasing = increasing && ids[i - 1] < ids[i];
+    }
+    TEST_CHECK( increasing );
+
+    auto a = xl::ulid();
+    TEST_CHECK_( a.length() == 26 && a[0] <= '7', "-> ulid:[%s]", a.c_str() );
+}
+
+// Ids from several threads: each thread's batches keep increasing and no
+// id repeats across threads
+void test_uuid_v7_2(void)
+{
+    using generate_fn = void (*)(xl::id128*, size_t);
+    const generate_fn generators[] = { xl::generate_uuid_v7, xl::generate_ulid };
+    const size_t thread_count = 8;
+    const size_t batches = 20;
+    const size_t batch_size = 1000;
+
+    for (auto generate : generators) {
+        std::vector<std::vector<xl::id128>> per_thread(thread_count);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < thread_count; t++) {
+            threads.emplace_back([&ids = per_thread[t], generate, batches, batch_size] {
+                ids.resize(batches * batch_size);
+                for (size_t b = 0; b < batches; b++) {
+                    generate(ids.data() + b * batch_size, batch_size);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        bool increasing = true;
+        std::vector<xl::id128> merged;
+        for (const auto& ids : per_thread) {
+            for (size_t i = 1; i < ids.size(); i++) {
+                increasing = increasing && ids[i - 1] < ids[i];
+            }
+            merged.insert(merged.end(), ids.begin(), ids.end());
+        }
+        std::sort(merged.begin(), merged.end());
+        const bool unique = std::adjacent_find(merged.begin(), merged.end()) == merged.end();
+        TEST_CHECK( increasing );
+        TEST_CHECK_( unique && merged.size() == thread_count * batches * batch_size, "-> ids:[%zu]", merged.size() );
+    }
+}
+
+// Known bytes to text
+void test_format_uuids_1(void)
+{
+    xl::id128 ids[2];
+    for (int i = 0; i < 16; i++) {
+        ids[0][i] = static_cast<uint8_t>(i * 17);
+        ids[1][i] = 0xff;
+    }
+
+    std::string text(2 * xl::uuid_string_length, '\0');
+    xl::format_uuids(ids, 2, &text[0]);
+    TEST_CHECK_( text == "00112233-4455-6677-8899-aabbccddeeff"
+        "ffffffff-ffff-ffff-ffff-ffffffffffff", "-> text:[%s]", text.c_str() );
+
+    std::string ulid_text(xl::ulid_string_length, '\0');
+    xl::format_ulids(&ids[1], 1, &ulid_text[0]);
+    TEST_CHECK_( ulid_text == "7ZZZZZZZZZZZZZZZZZZZZZZZZZ", "-> ulid:[%s]", ulid_text.c_str() );
+}
+
+// Compiled at compile time
+void test_string_pattern_1(void)
+{
+    constexpr xl::string_pattern plate("[A-Z]{3}-[0-9]{4}");
+    static_assert(plate.max_length() == 8, "plate is 8 chars");
+
+    auto a = xl::random_string_from_pattern(plate);
+    bool matches = a.length() == 8 && a[3] == '-';
+    for (int i = 0; i < 3; i++) {
+        matches = matches && a[i] >= 'A' && a[i] <= 'Z';
+        matches = matches && a[i + 4] >= '0' && a[i + 4] <= '9';
+    }
+    TEST_CHECK_( matches, "-> plate:[%s]", a.c_str() );
+}
+
+// Alternation, escapes and optional groups
+void test_string_pattern_2(void)
+{
+    auto a = xl::random_string_from_pattern("user_[a-z0-9]{8}@example\\.(com|org)");
+    TEST_CHECK_( a.length() == 25 && a.rfind("user_", 0) == 0, "-> email:[%s]", a.c_str() );
+    TEST_CHECK_( a.substr(13) == "@example.com" || a.substr(13) == "@example.org", "-> email:[%s]", a.c_str() );
+
+    auto b = xl::random_string_from_pattern("(ab){2,3}x?");
+    TEST_CHECK_( b == "abab" || b == "ababab" || b == "ababx" || b == "abababx", "-> str:[%s]", b.c_str() );
+}
+
+// Many strings into one buffer
+void test_string_pattern_3(void)
+{
+    xl::string_pattern digits("\\d{1,3}");
+    std::mt19937_64 rg{ 1234 };
+    std::string buffer;
+    digits.generate_n(buffer, 1000, ',', rg);
+
+    size_t separators = 0;
+    bool only_digits = true;
+    for (auto c : buffer) {
+        separators += (c == ',') ? 1 : 0;
+        only_digits = only_digits && (c == ',' || (c >= '0' && c <= '9'));
+    }
+    TEST_CHECK( separators == 1000 && only_digits );
+    TEST_CHECK( buffer.length() >= 2000 && buffer.length() <= 4000 );
+}
+
+void test_string_pattern_4(void)
+{
+    TEST_EXCEPTION(xl::string_pattern("[a-z"), std::invalid_argument);
+    TEST_EXCEPTION(xl::string_pattern("(ab"), std::invalid_argument);
+    TEST_EXCEPTION(xl::string_pattern("a{3,1}"), std::invalid_argument);
+    TEST_EXCEPTION(xl::string_pattern("*a"), std::invalid_argument);
+
+    // Letter escapes are not silently taken as the letter
+    TEST_EXCEPTION(xl::string_pattern("a\\sb"), std::invalid_argument);
+    TEST_EXCEPTION(xl::string_pattern("x\\ny"), std::invalid_argument);
+    TEST_EXCEPTION(xl::string_pattern("\\D{3}"), std::invalid_argument);
+    TEST_EXCEPTION(xl::string_pattern("[\\s]{2}"), std::invalid_argument);
+    TEST_EXCEPTION(xl::string_pattern("[a-\\z]"), std::invalid_argument);
+    TEST_CHECK( xl::string_pattern("\\.\\-[\\]x]").max_length() == 3 );
+}
+
+// Literals after an unquantified group follow every alternative
+void test_string_pattern_5(void)
+{
+    constexpr xl::string_pattern suffix("(a|b)c");
+    constexpr xl::string_pattern nested("x((com|org)\\.y|z)w");
+    std::mt19937_64 rg{ 99 };
+
+    bool suffix_ok = true;
+    bool nested_ok = true;
+    for (int i = 0; i < 200; i++) {
+        auto a = suffix.generate(rg);
+        suffix_ok = suffix_ok && (a == "ac" || a == "bc");
+
+        auto b = nested.generate(rg);
+        nested_ok = nested_ok && (b == "xcom.yw" || b == "xorg.yw" || b == "xzw");
+        TEST_MSG("nested:[%s]", b.c_str());
+    }
+    TEST_CHECK( suffix_ok );
+    TEST_CHECK( nested_ok );
+}
+
+// take(n) stops iteration, values stay in range
+void test_random_ints_1(void)
+{
+    size_t count = 0;
+    bool in_range = true;
+    for (auto v : xl::random_ints(5, 9).take(100)) {
+        in_range = in_range && v >= 5 && v <= 9;
+        count++;
+    }
+    TEST_CHECK_( count == 100, "-> count:[%zu]", count );
+    TEST_CHECK( in_range );
+}
+
+// Same seed, same stream
+void test_random_ints_2(void)
+{
+    std::vector<long> a(64);
+    std::vector<long> b(64);
+    xl::random_ints(0L, 1000000L).with_seed(42).next_batch(a);
+    xl::random_ints(0L, 1000000L).with_seed(42).next_batch(b);
+    TEST_CHECK( a == b );
+}
+
+// Breaking out of a loop and resuming, or switching to next_batch(),
+// stays within one take() budget
+void test_random_ints_3(void)
+{
+    auto dice = xl::random_ints(1, 6) | xl::take(3);
+    size_t count = 0;
+    for (auto v : dice) {
+        (void)v;
+        count++;
+        break;
+    }
+    for (auto v : dice) {
+        (void)v;
+        count++;
+    }
+    TEST_CHECK_( count == 3, "-> count:[%zu]", count );
+    TEST_CHECK( dice.remaining() == 0 );
+
+    auto rolls = xl::random_ints(1, 6) | xl::take(3);
+    auto it = rolls.begin();
+    TEST_CHECK( it != rolls.end() && *it >= 1 && *it <= 6 );
+    int buf[3] = {};
+    auto n = rolls.next_batch(buf, 3);
+    TEST_CHECK_( n == 2, "-> n:[%zu]", n );
+    TEST_CHECK( rolls.begin() == rolls.end() );
+}
+
+// take() on a named range continues its stream, an unbounded range stays
+// unbounded
+void test_random_ints_4(void)
+{
+    auto ints = xl::random_ints(0, 1000000);
+    std::vector<int> first;
+    std::vector<int> second;
+    for (auto v : ints | xl::take(5)) {
+        first.push_back(v);
+    }
+    for (auto v : ints | xl::take(5)) {
+        second.push_back(v);
+    }
+    TEST_CHECK( first.size() == 5 && second.size() == 5 );
+    TEST_CHECK( first != second );
+    TEST_CHECK( ints.remaining() == std::numeric_limits<size_t>::max() );
+
+    auto words = xl::random_strings(16, "abcdefghijklmnop");
+    std::string a;
+    std::string b;
+    TEST_CHECK( words.take(1).next(a) && words.take(1).next(b) );
+    TEST_CHECK_( a != b, "-> a:[%s] b:[%s]", a.c_str(), b.c_str() );
+
+    // A view draws from the underlying budget too
+    auto dice = xl::random_ints(1, 6) | xl::take(4);
+    int buf[8] = {};
+    TEST_CHECK( dice.take(3).next_batch(buf, 8) == 3 );
+    TEST_CHECK( (dice | xl::take(3)).next_batch(buf, 8) == 1 );
+    TEST_CHECK( dice.remaining() == 0 );
+}
+
+// Chunked pulls end where take() does
+void test_random_reals_1(void)
+{
+    auto reals = xl::random_reals(3.2, 14.777) | xl::take(10000);
+    std::vector<double> chunk(4096);
+    size_t total = 0;
+    size_t pulls = 0;
+    bool in_range = true;
+    for (size_t n = reals.next_batch(chunk); n > 0; n = reals.next_batch(chunk)) {
+        for (size_t i = 0; i < n; i++) {
+            in_range = in_range && chunk[i] >= 3.2 && chunk[i] < 14.777;
+        }
+        total += n;
+        pulls++;
+    }
+    TEST_CHECK_( total == 10000 && pulls == 3, "-> total:[%zu] pulls:[%zu]", total, pulls );
+    TEST_CHECK( in_range );
+}
+
+void test_random_strings_1(void)
+{
+    size_t count = 0;
+    bool valid = true;
+    for (const auto& s : xl::random_strings(9, "abcd") | xl::take(50)) {
+        valid = valid && s.length() == 9 && s.find_first_not_of("abcd") == std::string::npos;
+        count++;
+    }
+    TEST_CHECK( count == 50 && valid );
+    TEST_EXCEPTION(xl::random_strings(4, ""), std::invalid_argument);
+}
+
+#ifdef XHANALIB_HAS_COROUTINES
+void test_as_generator_1(void)
+{
+    size_t count = 0;
+    for (int v : xl::as_generator(xl::random_ints(1, 6) | xl::take(20))) {
+        TEST_CHECK( v >= 1 && v <= 6 );
+        count++;
+    }
+    TEST_CHECK( count == 20 );
+
+    auto ints = xl::random_ints(0, 1000000) | xl::take(10);
+    std::vector<int> values;
+    for (int v : xl::as_generator(ints)) {
+        values.push_back(v);
+        if (values.size() == 4)
+            break;
+    }
+    TEST_CHECK( ints.remaining() == 6 );
+}
+#endif
+
 // https://github.com/mity/acutest/tree/master
 // cmake --build . && ctest -C Debug -V
 
@@ -335,5 +782,32 @@ TEST_LIST = {
     { "equal_to_n_decimal_places() 1", test_equal_to_n_decimal_places_1 },
     { "equal_to_n_decimal_places() 2", test_equal_to_n_decimal_places_2 },
     { "equal_to_n_decimal_places() 3", test_equal_to_n_decimal_places_3 },
+    { "second_translation_unit() 1", test_second_translation_unit_1 },
+    { "sample_resource_usage() 1", test_sample_resource_usage_1 },
+    { "resource_scope() 1", test_resource_scope_1 },
+    { "resource_sampler() 1", test_resource_sampler_1 },
+    { "bench() 1", test_bench_1 },
+    { "bench_with_setup() 1", test_bench_with_setup_1 },
+    { "summarize_bench_samples() 1", test_summarize_bench_samples_1 },
+    { "bench to_json() 1", test_bench_to_json_1 },
+    { "uuid_v4() 1", test_uuid_v4_1 },
+    { "uuid_v7() 1", test_uuid_v7_1 },
+    { "uuid_v7() 2 - threads, with ulid()", test_uuid_v7_2 },
+    { "ulid() 1", test_ulid_1 },
+    { "format_uuids() 1", test_format_uuids_1 },
+    { "string_pattern() 1 - constexpr", test_string_pattern_1 },
+    { "string_pattern() 2 - groups", test_string_pattern_2 },
+    { "string_pattern() 3 - bulk", test_string_pattern_3 },
+    { "string_pattern() 4 - errors", test_string_pattern_4 },
+    { "string_pattern() 5 - literal after group", test_string_pattern_5 },
+    { "random_ints() 1 - take", test_random_ints_1 },
+    { "random_ints() 2 - seed", test_random_ints_2 },
+    { "random_ints() 3 - resume", test_random_ints_3 },
+    { "random_ints() 4 - named range", test_random_ints_4 },
+    { "random_reals() 1 - next_batch", test_random_reals_1 },
+    { "random_strings() 1", test_random_strings_1 },
+#ifdef XHANALIB_HAS_COROUTINES
+    { "as_generator() 1", test_as_generator_1 },
+#endif
     { NULL, NULL }     /* zeroed record marking the end of the list */
 };
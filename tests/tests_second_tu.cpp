@@ -0,0 +1,25 @@
+#include "xhanalib.h"
+
+namespace xl = xhanalib;
+
+//
+// Second translation unit of the test suite. Including xhanalib.h and using
+// its non-template functions here as well as in tests.cpp makes sure the
+// header links cleanly when included from more than one .cpp file.
+//
+
+auto second_tu_platform_name() -> const char *
+{
+    return xl::get_platform_name();
+}
+
+auto second_tu_deserialize_key_value(const std::string& in_str,
+    std::map<std::string, std::string>& out_map) -> bool
+{
+    return xl::deserialize_key_value(in_str, '=', '&', out_map);
+}
+
+auto second_tu_timestamp() -> std::string
+{
+    return xl::get_current_timestamp();
+}